@@ -5,40 +5,111 @@
 #include "IO/BINARY_TOOLS//BinaryFileReader.hpp"
 #include "IO/BINARY_TOOLS//BinaryFileWriter.hpp"
 #include "IO/BINARY_TOOLS/Decoder.hpp"
+#include "IO/BINARY_TOOLS/DecompressingReader.hpp"
+#include "IO/BINARY_TOOLS/AsyncWriter.hpp"
+#include "IO/BINARY_TOOLS/CompressingWriter.hpp"
 #include "IO/BINARY_TOOLS/Encoder.hpp"
+#include "IO/BINARY_TOOLS/ReadAheadReader.hpp"
 #include "IO/InputStream.hpp"
 #include "IO/OutputStream.hpp"
+#include "IO/parallel_chunks.hpp"
+#include "IO/columnar.hpp"
+#include "IO/convert.hpp"
 #include "IO/Splitter.hpp"
+#include "IO/LineSplitter.hpp"
+#include "IO/Tokenizer.hpp"
 #include "IO/string_to.hpp"
+#include "IO/trace.hpp"
 
 
 namespace ACCBOOST2::IO
 {
 
+  // note: buffer_size はストリームのバッファの要素数で，0 ならばファイルの種類や大きさに応じて決める（InputStream, OutputStream を参照）．
+
   inline struct InputMode {} IN;
 
+  /**
+   * gzip または zstd で圧縮されたファイルは，先頭のマジックナンバーで判定して別スレッドで伸長しながら読む
+   * （BINARY_TOOLS::make_decompressing_reader を参照）．
+   */
+  template<class CharType>
+  InputStream<CharType> open(const std::string& file_path, InputMode, const std::string& encoding = "ascii", std::size_t buffer_size = 0)
+  {
+    return InputStream<CharType>(BINARY_TOOLS::make_decoder<CharType>(BINARY_TOOLS::make_decompressing_reader(BINARY_TOOLS::make_binary_file_reader(file_path)), encoding), buffer_size);
+  }
+
+  inline struct ASCIIEncoding {} ASCII;
+
+  inline struct UTF8Encoding {} UTF8;
+
+  /// 文字コードをコンパイル時に指定して開く．読み込みとデコードは仮想関数を介さずにインライン化される．
+  template<class CharType>
+  requires(
+    std::is_same_v<CharType, char8_t>
+  )
+  InputStream<CharType, BINARY_TOOLS::AsciiDecoder<BINARY_TOOLS::FileReader>> open(const std::string& file_path, InputMode, ASCIIEncoding, std::size_t buffer_size = 0)
+  {
+    using ReaderType = BINARY_TOOLS::AsciiDecoder<BINARY_TOOLS::FileReader>;
+    return InputStream<CharType, ReaderType>(ReaderType(BINARY_TOOLS::FileReader(file_path)), buffer_size);
+  }
+
+  template<class CharType>
+  requires(
+    std::is_same_v<CharType, char8_t>
+  )
+  InputStream<CharType, BINARY_TOOLS::UTF8Decoder<BINARY_TOOLS::FileReader>> open(const std::string& file_path, InputMode, UTF8Encoding, std::size_t buffer_size = 0)
+  {
+    using ReaderType = BINARY_TOOLS::UTF8Decoder<BINARY_TOOLS::FileReader>;
+    return InputStream<CharType, ReaderType>(ReaderType(BINARY_TOOLS::FileReader(file_path)), buffer_size);
+  }
+
+  inline struct AsyncInputMode {} ASYNC_IN;
+
+  /// 別スレッドでファイルを先読みしながら読み込む（BINARY_TOOLS::make_read_ahead_reader を参照）．
   template<class CharType>
-  InputStream<CharType> open(const std::string& file_path, InputMode, const std::string& encoding = "ascii")
+  InputStream<CharType> open(const std::string& file_path, AsyncInputMode, const std::string& encoding = "ascii", std::size_t buffer_size = 0)
   {
-    return InputStream<CharType>(BINARY_TOOLS::make_decoder<CharType>(BINARY_TOOLS::make_binary_file_reader(file_path), encoding));
+    return InputStream<CharType>(BINARY_TOOLS::make_decoder<CharType>(BINARY_TOOLS::make_read_ahead_reader(BINARY_TOOLS::make_decompressing_reader(BINARY_TOOLS::make_binary_file_reader(file_path), false)), encoding), buffer_size);
+  }
+
+  inline struct OutputMode {} OUT;
+
+  /**
+   * 拡張子が ".gz" または ".zst" のファイルは，compression の設定で圧縮しながら書き込む
+   * （BINARY_TOOLS::make_compressing_file_writer を参照）．
+   */
+  template<class CharType>
+  OutputStream<CharType> open(const std::string& file_path, OutputMode, const std::string& encoding = "ascii", std::size_t buffer_size = 0, const BINARY_TOOLS::CompressionOptions& compression = {})
+  {
+    return OutputStream<CharType>(BINARY_TOOLS::make_encoder<CharType>(BINARY_TOOLS::make_compressing_file_writer(file_path, compression), encoding), buffer_size);
+  }
+
+  inline struct AsyncOutputMode {} ASYNC_OUT;
+
+  /// 別スレッドでファイルに書き込む（BINARY_TOOLS::make_async_writer を参照）．flush() は書き込みが終わるまで待つ．
+  template<class CharType>
+  OutputStream<CharType> open(const std::string& file_path, AsyncOutputMode, const std::string& encoding = "ascii", std::size_t buffer_size = 0, const BINARY_TOOLS::CompressionOptions& compression = {})
+  {
+    return OutputStream<CharType>(BINARY_TOOLS::make_encoder<CharType>(BINARY_TOOLS::make_async_writer(BINARY_TOOLS::make_compressing_file_writer(file_path, compression)), encoding), buffer_size);
   }
 
   template<class CharType>
-  InputStream<CharType> make_stdin_stream(const std::string& encoding = "ascii")
+  InputStream<CharType> make_stdin_stream(const std::string& encoding = "ascii", std::size_t buffer_size = 0)
   {
-    return InputStream<CharType>(BINARY_TOOLS::make_decoder<CharType>(BINARY_TOOLS::make_binary_stdin_reader(), encoding));
+    return InputStream<CharType>(BINARY_TOOLS::make_decoder<CharType>(BINARY_TOOLS::make_binary_stdin_reader(), encoding), buffer_size);
   }
 
   template<class CharType>
-  OutputStream<CharType> make_stdout_stream(const std::string& encoding = "ascii")
+  OutputStream<CharType> make_stdout_stream(const std::string& encoding = "ascii", std::size_t buffer_size = 0)
   {
-    return OutputStream<CharType>(BINARY_TOOLS::make_encoder<CharType>(BINARY_TOOLS::make_binary_stdout_writer(), encoding));
+    return OutputStream<CharType>(BINARY_TOOLS::make_encoder<CharType>(BINARY_TOOLS::make_binary_stdout_writer(), encoding), buffer_size);
   }
 
   template<class CharType>
-  OutputStream<CharType> make_stderr_stream(const std::string& encoding = "ascii")
+  OutputStream<CharType> make_stderr_stream(const std::string& encoding = "ascii", std::size_t buffer_size = 0)
   {
-    return OutputStream<CharType>(BINARY_TOOLS::make_encoder<CharType>(BINARY_TOOLS::make_binary_stderr_writer(), encoding));
+    return OutputStream<CharType>(BINARY_TOOLS::make_encoder<CharType>(BINARY_TOOLS::make_binary_stderr_writer(), encoding), buffer_size);
   }
 
   template<class InputStreamType, class CharType>
@@ -47,6 +118,22 @@ namespace ACCBOOST2::IO
     return Splitter<InputStreamType, CharType>(std::forward<InputStreamType>(input_stream), delimiter);
   }
 
+  /// input_stream を行に分ける（LineSplitter を参照）．行の内容は次の行に進むまで有効．
+  template<class InputStreamType>
+  decltype(auto) lines(InputStreamType&& input_stream)
+  {
+    using CharType = std::remove_cv_t<std::remove_reference_t<decltype(*input_stream.begin())>>;
+    return LineSplitter<InputStreamType, CharType>(std::forward<InputStreamType>(input_stream));
+  }
+
+  /// input_stream を format（IO::CSV, IO::WHITESPACE など）に従ってフィールドに分ける（Tokenizer を参照）．
+  template<class InputStreamType>
+  decltype(auto) tokenize(InputStreamType&& input_stream, const TokenizerFormat& format)
+  {
+    using CharType = std::remove_cv_t<std::remove_reference_t<decltype(*input_stream.begin())>>;
+    return Tokenizer<InputStreamType, CharType>(std::forward<InputStreamType>(input_stream), format);
+  }
+
 
 }
 
@@ -0,0 +1,219 @@
+#ifndef ACCBOOST2_IO_BINARY_TOOLS_ASYNCWRITER_HPP_
+#define ACCBOOST2_IO_BINARY_TOOLS_ASYNCWRITER_HPP_
+
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Writer.hpp"
+
+
+namespace ACCBOOST2::IO::BINARY_TOOLS
+{
+
+  namespace _impl_AsyncWriter
+  {
+
+    /**
+     * 別スレッドで writer に書き込む BinaryWriter．
+     * 大きさ buffer_size のバッファを number_of_buffers 個の環状バッファとして持ち，
+     * operator() は現在のバッファにコピーし，一杯になったバッファを書き込み側のスレッドに渡して次のバッファに移る．
+     * 全てのバッファが書き込み待ちの場合のみ operator() は待たされる．
+     * 書き込み側で発生した例外は，次の operator() または flush() で投げ直す．
+     * close() の後は書き込めず，flush() と close() は何もしない．
+     */
+    class AsyncWriter: public BinaryWriter
+    {
+    private:
+
+      struct Block
+      {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+      };
+
+      std::unique_ptr<BinaryWriter> writer_;
+      std::size_t buffer_size_;
+      std::vector<Block> blocks_;
+      // 書き込み側のスレッドが次に書き込むバッファの番号
+      std::size_t head_;
+      // 呼び出し側が埋めているバッファの番号
+      std::size_t current_;
+      // 書き込み待ち（書き込み中を含む）のバッファの数
+      std::size_t number_of_queued_;
+      bool closing_;
+      // close() が呼ばれたか（呼び出し側のスレッドのみが触れる）
+      bool closed_;
+      std::exception_ptr error_;
+      std::mutex mutex_;
+      std::condition_variable queued_;
+      std::condition_variable written_;
+      std::thread thread_;
+
+      void run() noexcept
+      {
+        while(1){
+          {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queued_.wait(lock, [&]{return closing_ || number_of_queued_ != 0;});
+            if(number_of_queued_ == 0) return;
+          }
+          // note: 書き込み待ちのバッファには書き込み側のスレッドしか触れないので，ロックせずに読む．
+          Block& block = blocks_[head_];
+          std::exception_ptr error;
+          try{
+            (*writer_)(block.data.get(), block.size);
+          }catch(...){
+            error = std::current_exception();
+          }
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(error != nullptr && error_ == nullptr){
+              error_ = error;
+            }
+            block.size = 0;
+            head_ = (head_ + 1) % blocks_.size();
+            --number_of_queued_;
+          }
+          written_.notify_one();
+        }
+      }
+
+      void _rethrow_if_failed()
+      {
+        if(error_ != nullptr){
+          std::exception_ptr error = error_;
+          error_ = nullptr;
+          std::rethrow_exception(error);
+        }
+      }
+
+      /// 現在のバッファを書き込み待ちにし，空いたバッファに移る．
+      void _submit()
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++number_of_queued_;
+        queued_.notify_one();
+        written_.wait(lock, [&]{return number_of_queued_ < blocks_.size();});
+        current_ = (current_ + 1) % blocks_.size();
+        assert(blocks_[current_].size == 0);
+        _rethrow_if_failed();
+      }
+
+      /// 全てのバッファを書き込み終えるまで待つ．
+      void _drain()
+      {
+        if(blocks_[current_].size != 0){
+          _submit();
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        written_.wait(lock, [&]{return number_of_queued_ == 0;});
+        _rethrow_if_failed();
+      }
+
+    public:
+
+      AsyncWriter(std::unique_ptr<BinaryWriter>&& writer, std::size_t number_of_buffers, std::size_t buffer_size):
+        writer_(std::move(writer)),
+        buffer_size_(std::max<std::size_t>(buffer_size, 1)),
+        blocks_(std::max<std::size_t>(number_of_buffers, 1)),
+        head_(0), current_(0), number_of_queued_(0), closing_(false), closed_(false), error_(), mutex_(), queued_(), written_(), thread_()
+      {
+        assert(writer_ != nullptr);
+        assert(number_of_buffers >= 1);
+        for(auto& block: blocks_){
+          block.data = std::make_unique_for_overwrite<std::byte[]>(buffer_size_);
+        }
+        thread_ = std::thread([this]{run();});
+      }
+
+      /// 残っているデータを書き出してからスレッドを止める（close() の後はスレッドを止めるだけ）．ここで発生した書き込みの例外は無視される．
+      ~AsyncWriter() noexcept
+      {
+        if(!closed_){
+          try{
+            flush();
+          }catch(...){
+            // note: デストラクタから例外は投げられないので無視する．
+          }
+        }
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          closing_ = true;
+        }
+        queued_.notify_one();
+        thread_.join();
+      }
+
+      void operator()(const char_type* buffer, std::size_t size) override
+      {
+        assert(!closed_);
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          _rethrow_if_failed();
+        }
+        while(size != 0){
+          Block& block = blocks_[current_];
+          const std::size_t n = std::min(size, buffer_size_ - block.size);
+          std::memcpy(block.data.get() + block.size, buffer, n);
+          block.size += n;
+          buffer += n;
+          size -= n;
+          if(block.size == buffer_size_){
+            _submit();
+          }
+        }
+      }
+
+      std::size_t preferred_buffer_size() const noexcept override
+      {
+        return writer_->preferred_buffer_size();
+      }
+
+      /// 全てのバッファを書き込み終えるまで待ち，writer にも書き出させる．
+      void flush() override
+      {
+        if(closed_) return;
+        _drain();
+        writer_->flush();
+      }
+
+      /// 全てのバッファを書き込み終えるまで待ち，writer を閉じる．失敗して例外を投げた場合も閉じたものとみなす．
+      void close() override
+      {
+        if(closed_) return;
+        closed_ = true;
+        _drain();
+        writer_->close();
+      }
+
+    // deleted:
+
+      AsyncWriter(AsyncWriter&&) = delete;
+      AsyncWriter(const AsyncWriter&) = delete;
+      AsyncWriter& operator=(AsyncWriter&&) = delete;
+      AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    };
+
+  }
+
+
+  /**
+   * writer へ別スレッドで書き込む BinaryWriter を作る．
+   * 大きさ buffer_size のバッファを number_of_buffers 個持ち，一杯になったものから順に書き込む．
+   */
+  static inline std::unique_ptr<BinaryWriter> make_async_writer(std::unique_ptr<BinaryWriter>&& writer, std::size_t number_of_buffers = 4, std::size_t buffer_size = 1 << 20)
+  {
+    return std::make_unique<_impl_AsyncWriter::AsyncWriter>(std::move(writer), number_of_buffers, buffer_size);
+  }
+
+}
+
+
+#endif
@@ -9,6 +9,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include "Reader.hpp"
+#include "../trace.hpp"
 
 
 namespace ACCBOOST2::IO::BINARY_TOOLS
@@ -23,6 +24,10 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
 
       static constexpr std::size_t default_min_buffer_size = 1024;
 
+      static constexpr std::size_t max_file_buffer_size = 1 << 18;
+
+      static constexpr std::size_t pipe_buffer_size = 1 << 16;
+
       int fd_;
 
     public:
@@ -45,6 +50,27 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
         }
       }
 
+      /**
+       * 通常のファイルではファイルの大きさ（ただし max_file_buffer_size まで），
+       * パイプとソケットでは pipe_buffer_size，それ以外（端末など）では min_buffer_size() とする．
+       */
+      std::size_t preferred_buffer_size() const noexcept override
+      {
+        const std::size_t min_size = min_buffer_size();
+        if(fd_ < 0) return min_size;
+        struct stat st;
+        if(::fstat(fd_, &st) != 0) return min_size;
+        if(S_ISREG(st.st_mode)){
+          // ファイルの大きさを min_size の倍数に切り上げる．
+          const std::size_t file_size = st.st_size > 0 ? static_cast<std::size_t>(st.st_size) : 0;
+          return std::clamp((file_size + min_size - 1) / min_size * min_size, min_size, std::max(min_size, max_file_buffer_size));
+        }else if(S_ISFIFO(st.st_mode) || S_ISSOCK(st.st_mode)){
+          return std::max(min_size, pipe_buffer_size);
+        }else{
+          return min_size;
+        }
+      }
+
       std::size_t operator()(char_type* buffer, std::size_t limit) override
       {
         if(fd_ < 0) return 0;
@@ -52,8 +78,10 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
           // limit を default_min_buffer_size の倍数に切り下げる．
           limit = limit / default_min_buffer_size * default_min_buffer_size;
         }
+        TraceScope trace(TraceStage::read);
         auto result = ::read(fd_, buffer, limit);
         if(result < 0) throw std::runtime_error("read() failure.");
+        trace.add_bytes(result);
         return result;
       }
 
@@ -65,7 +93,7 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
     };
 
 
-    class BinaryFileReader: public BinaryFDReader
+    class BinaryFileReader final: public BinaryFDReader
     {
     private:
 
@@ -82,7 +110,11 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
         BinaryFDReader(open(path))
       {}
 
-      BinaryFileReader(BinaryFileReader&& other) = default;
+      BinaryFileReader(BinaryFileReader&& other) noexcept:
+        BinaryFDReader(other.fd_)
+      {
+        other.fd_ = -1;
+      }
 
       ~BinaryFileReader() noexcept
       {
@@ -105,6 +137,15 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
   }
 
 
+  /**
+   * ファイル記述子から読み込む BinaryReader．
+   * 値として持てば静的な Reader として使え（UTF8Decoder<FileReader> など），呼び出しは仮想関数を介さない．
+   */
+  using FDReader = _impl_BinaryFileReader::BinaryFDReader;
+
+  /// ファイルを開いて読み込む BinaryReader（FDReader と同様に静的な Reader としても使える）．
+  using FileReader = _impl_BinaryFileReader::BinaryFileReader;
+
   static inline std::unique_ptr<BinaryReader> make_binary_fd_reader(int file_descriptor)
   {
     return std::make_unique<_impl_BinaryFileReader::BinaryFDReader>(file_descriptor);
@@ -8,6 +8,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include "Writer.hpp"
+#include "../trace.hpp"
 
 
 namespace ACCBOOST2::IO::BINARY_TOOLS
@@ -18,6 +19,10 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
   {
   protected:
 
+    static constexpr std::size_t file_buffer_size = 1 << 18;
+
+    static constexpr std::size_t pipe_buffer_size = 1 << 16;
+
     int fd_;
 
   public:
@@ -28,10 +33,26 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
       assert(fd_ >= 0);
     }
 
+    /// 通常のファイルでは file_buffer_size，パイプとソケットでは pipe_buffer_size，それ以外（端末など）では指定しない．
+    std::size_t preferred_buffer_size() const noexcept override
+    {
+      struct stat st;
+      if(fd_ < 0 || ::fstat(fd_, &st) != 0) return 0;
+      if(S_ISREG(st.st_mode)){
+        return file_buffer_size;
+      }else if(S_ISFIFO(st.st_mode) || S_ISSOCK(st.st_mode)){
+        return pipe_buffer_size;
+      }else{
+        return 0;
+      }
+    }
+
     void operator()(const char_type* buffer, std::size_t size) override
     {
       assert(fd_ >= 0);
       auto bytes = size * sizeof(char_type);
+      TraceScope trace(TraceStage::write);
+      trace.add_bytes(bytes);
       auto result = ::write(fd_, buffer, bytes);
       if(result < 0) throw std::runtime_error("write() failure.");
       assert(static_cast<std::size_t>(result) == bytes);
@@ -62,6 +83,16 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
         fd_ = -1;
       }
     }
+
+    /// ファイルを閉じる．NFS などでは書き込みのエラーが close() で初めて報告される．
+    void close() override
+    {
+      if(fd_ >= 0){
+        auto result = ::close(fd_);
+        fd_ = -1;
+        if(result != 0) throw std::runtime_error("close() failure.");
+      }
+    }
   };
 
   static inline std::unique_ptr<BinaryWriter> make_binary_file_writer(const std::string& path)
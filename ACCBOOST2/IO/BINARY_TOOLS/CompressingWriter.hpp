@@ -0,0 +1,331 @@
+#ifndef ACCBOOST2_IO_BINARY_TOOLS_COMPRESSINGWRITER_HPP_
+#define ACCBOOST2_IO_BINARY_TOOLS_COMPRESSINGWRITER_HPP_
+
+
+/**
+ * 圧縮しながら書き込む BinaryWriter．
+ * ACCBOOST2_IO_ZLIB を定義すると gzip（zlib が必要，-lz でリンクする），
+ * ACCBOOST2_IO_ZSTD を定義すると zstd（libzstd が必要，-lzstd でリンクする）に対応する（DecompressingReader.hpp と同じ）．
+ * ストリームの終端はデストラクタでも書くがエラーは無視されるので，書き込みの失敗を知るには close() を呼ぶ（OutputStream::close() を参照）．
+ */
+
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include "Writer.hpp"
+#include "AsyncWriter.hpp"
+#include "BinaryFileWriter.hpp"
+#include "../trace.hpp"
+
+#if defined(ACCBOOST2_IO_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(ACCBOOST2_IO_ZSTD)
+#include <zstd.h>
+#endif
+
+
+namespace ACCBOOST2::IO::BINARY_TOOLS
+{
+
+  /// 圧縮の設定．
+  struct CompressionOptions
+  {
+    /// 圧縮レベル（std::nullopt ならば形式ごとの既定値）
+    std::optional<int> level = std::nullopt;
+    /// 圧縮に使うスレッドの数（0 ならば呼び出し側のスレッドで圧縮する）
+    unsigned number_of_threads = 0;
+  };
+
+
+  namespace _impl_CompressingWriter
+  {
+
+    static constexpr std::size_t output_buffer_size = 1 << 16;
+
+#if defined(ACCBOOST2_IO_ZLIB)
+
+    /**
+     * gzip 形式で圧縮して writer に書き込む BinaryWriter．
+     * flush() では Z_SYNC_FLUSH でそれまでのデータを伸長できる状態にし，デストラクタでストリームを終える．
+     */
+    class GzipWriter: public BinaryWriter
+    {
+    private:
+
+      std::unique_ptr<BinaryWriter> writer_;
+      std::unique_ptr<std::byte[]> output_;
+      z_stream stream_;
+      bool closed_;
+
+      void _deflate(int flush)
+      {
+        do{
+          stream_.next_out = reinterpret_cast<Bytef*>(output_.get());
+          stream_.avail_out = static_cast<uInt>(output_buffer_size);
+          if(::deflate(&stream_, flush) == Z_STREAM_ERROR) throw std::runtime_error("deflate() failure.");
+          const std::size_t n = output_buffer_size - stream_.avail_out;
+          if(n != 0){
+            (*writer_)(output_.get(), n);
+          }
+        }while(stream_.avail_out == 0);
+      }
+
+    public:
+
+      GzipWriter(std::unique_ptr<BinaryWriter>&& writer, int level):
+        writer_(std::move(writer)),
+        output_(std::make_unique_for_overwrite<std::byte[]>(output_buffer_size)),
+        stream_(),
+        closed_(false)
+      {
+        assert(writer_ != nullptr);
+        // note: windowBits に 16 を加えると gzip のヘッダとトレーラを付ける．
+        if(::deflateInit2(&stream_, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK){
+          throw std::runtime_error("deflateInit2() failure.");
+        }
+      }
+
+      /// close() していなければストリームを終えて書き出す．ここで発生した書き込みの例外は無視される．
+      ~GzipWriter() noexcept
+      {
+        if(!closed_){
+          try{
+            close();
+          }catch(...){
+            // note: デストラクタから例外は投げられないので無視する．
+          }
+        }
+        ::deflateEnd(&stream_);
+      }
+
+      void operator()(const char_type* buffer, std::size_t size) override
+      {
+        TraceScope trace(TraceStage::compress);
+        trace.add_bytes(size);
+        while(size != 0){
+          const std::size_t n = std::min<std::size_t>(size, std::numeric_limits<uInt>::max());
+          stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char_type*>(buffer));
+          stream_.avail_in = static_cast<uInt>(n);
+          _deflate(Z_NO_FLUSH);
+          assert(stream_.avail_in == 0);
+          buffer += n;
+          size -= n;
+        }
+      }
+
+      std::size_t preferred_buffer_size() const noexcept override
+      {
+        return output_buffer_size;
+      }
+
+      void flush() override
+      {
+        _deflate(Z_SYNC_FLUSH);
+        writer_->flush();
+      }
+
+      /// gzip のトレーラを書き，writer を閉じる．
+      void close() override
+      {
+        assert(!closed_);
+        // note: 失敗した場合にデストラクタで書き直さないよう，先に閉じたことにする．
+        closed_ = true;
+        _deflate(Z_FINISH);
+        writer_->close();
+      }
+
+    // deleted:
+
+      GzipWriter(GzipWriter&&) = delete;
+      GzipWriter(const GzipWriter&) = delete;
+      GzipWriter& operator=(GzipWriter&&) = delete;
+      GzipWriter& operator=(const GzipWriter&) = delete;
+
+    };
+
+#endif
+
+
+#if defined(ACCBOOST2_IO_ZSTD)
+
+    /**
+     * zstd 形式で圧縮して writer に書き込む BinaryWriter．
+     * number_of_threads が 1 以上ならば libzstd のワーカースレッドで圧縮する（libzstd がマルチスレッドに対応している場合）．
+     * flush() ではそれまでのデータを伸長できる状態にし，デストラクタでフレームを終える．
+     */
+    class ZstdWriter: public BinaryWriter
+    {
+    private:
+
+      std::unique_ptr<BinaryWriter> writer_;
+      std::size_t output_size_;
+      std::unique_ptr<std::byte[]> output_;
+      ZSTD_CCtx* context_;
+      bool multithreaded_;
+      bool closed_;
+
+      void _compress(const void* buffer, std::size_t size, ZSTD_EndDirective mode)
+      {
+        ZSTD_inBuffer in{buffer, size, 0};
+        while(1){
+          ZSTD_outBuffer out{output_.get(), output_size_, 0};
+          auto remaining = ::ZSTD_compressStream2(context_, &out, &in, mode);
+          if(::ZSTD_isError(remaining)){
+            throw std::runtime_error(std::string("ZSTD_compressStream2() failure: ") + ::ZSTD_getErrorName(remaining) + ".");
+          }
+          if(out.pos != 0){
+            (*writer_)(output_.get(), out.pos);
+          }
+          if(mode == ZSTD_e_continue ? in.pos == in.size : remaining == 0) break;
+        }
+      }
+
+    public:
+
+      ZstdWriter(std::unique_ptr<BinaryWriter>&& writer, int level, unsigned number_of_threads):
+        writer_(std::move(writer)),
+        output_size_(::ZSTD_CStreamOutSize()),
+        output_(std::make_unique_for_overwrite<std::byte[]>(output_size_)),
+        context_(::ZSTD_createCCtx()),
+        multithreaded_(false),
+        closed_(false)
+      {
+        assert(writer_ != nullptr);
+        if(context_ == nullptr) throw std::runtime_error("ZSTD_createCCtx() failure.");
+        if(::ZSTD_isError(::ZSTD_CCtx_setParameter(context_, ZSTD_c_compressionLevel, level))){
+          ::ZSTD_freeCCtx(context_);
+          throw std::runtime_error("Invalid zstd compression level.");
+        }
+        if(number_of_threads != 0){
+          // note: マルチスレッドに対応していない libzstd ではエラーになる．
+          multithreaded_ = !::ZSTD_isError(::ZSTD_CCtx_setParameter(context_, ZSTD_c_nbWorkers, static_cast<int>(number_of_threads)));
+        }
+      }
+
+      /// close() していなければフレームを終えて書き出す．ここで発生した書き込みの例外は無視される．
+      ~ZstdWriter() noexcept
+      {
+        if(!closed_){
+          try{
+            close();
+          }catch(...){
+            // note: デストラクタから例外は投げられないので無視する．
+          }
+        }
+        ::ZSTD_freeCCtx(context_);
+      }
+
+      /// libzstd のワーカースレッドで圧縮しているか．
+      bool multithreaded() const noexcept
+      {
+        return multithreaded_;
+      }
+
+      void operator()(const char_type* buffer, std::size_t size) override
+      {
+        TraceScope trace(TraceStage::compress);
+        trace.add_bytes(size);
+        _compress(buffer, size, ZSTD_e_continue);
+      }
+
+      std::size_t preferred_buffer_size() const noexcept override
+      {
+        return ::ZSTD_CStreamInSize();
+      }
+
+      void flush() override
+      {
+        _compress(nullptr, 0, ZSTD_e_flush);
+        writer_->flush();
+      }
+
+      /// フレームを終えて書き，writer を閉じる．
+      void close() override
+      {
+        assert(!closed_);
+        closed_ = true;
+        _compress(nullptr, 0, ZSTD_e_end);
+        writer_->close();
+      }
+
+    // deleted:
+
+      ZstdWriter(ZstdWriter&&) = delete;
+      ZstdWriter(const ZstdWriter&) = delete;
+      ZstdWriter& operator=(ZstdWriter&&) = delete;
+      ZstdWriter& operator=(const ZstdWriter&) = delete;
+
+    };
+
+#endif
+
+  }
+
+
+#if defined(ACCBOOST2_IO_ZLIB)
+
+  /**
+   * gzip 形式で圧縮して writer に書き込む BinaryWriter を作る．
+   * options.number_of_threads が 1 以上ならば圧縮を別スレッドで行い（make_async_writer を参照），呼び出し側の処理と重ねる．
+   */
+  static inline std::unique_ptr<BinaryWriter> make_gzip_writer(std::unique_ptr<BinaryWriter>&& writer, const CompressionOptions& options = {})
+  {
+    std::unique_ptr<BinaryWriter> result = std::make_unique<_impl_CompressingWriter::GzipWriter>(std::move(writer), options.level.value_or(Z_DEFAULT_COMPRESSION));
+    return options.number_of_threads != 0 ? make_async_writer(std::move(result)) : std::move(result);
+  }
+
+#endif
+
+#if defined(ACCBOOST2_IO_ZSTD)
+
+  /**
+   * zstd 形式で圧縮して writer に書き込む BinaryWriter を作る．
+   * options.number_of_threads が 1 以上ならば libzstd のワーカースレッドで圧縮する．
+   * libzstd がマルチスレッドに対応していなければ，make_gzip_writer と同様に圧縮を別スレッドで行う．
+   */
+  static inline std::unique_ptr<BinaryWriter> make_zstd_writer(std::unique_ptr<BinaryWriter>&& writer, const CompressionOptions& options = {})
+  {
+    auto result = std::make_unique<_impl_CompressingWriter::ZstdWriter>(std::move(writer), options.level.value_or(ZSTD_CLEVEL_DEFAULT), options.number_of_threads);
+    if(options.number_of_threads != 0 && !result->multithreaded()){
+      return make_async_writer(std::move(result));
+    }
+    return result;
+  }
+
+#endif
+
+  /**
+   * ファイルを開き，拡張子が ".gz" ならば gzip 形式，".zst" ならば zstd 形式で圧縮して書き込む BinaryWriter を作る．
+   * それ以外の拡張子ならば圧縮しない．
+   * 対応する ACCBOOST2_IO_ZLIB または ACCBOOST2_IO_ZSTD が定義されていない形式ならば例外を投げる．
+   */
+  static inline std::unique_ptr<BinaryWriter> make_compressing_file_writer(const std::string& path, const CompressionOptions& options = {})
+  {
+    if(path.ends_with(".gz")){
+#if defined(ACCBOOST2_IO_ZLIB)
+      return make_gzip_writer(make_binary_file_writer(path), options);
+#else
+      throw std::runtime_error("Writing gzip-compressed output requires ACCBOOST2_IO_ZLIB.");
+#endif
+    }else if(path.ends_with(".zst")){
+#if defined(ACCBOOST2_IO_ZSTD)
+      return make_zstd_writer(make_binary_file_writer(path), options);
+#else
+      throw std::runtime_error("Writing zstd-compressed output requires ACCBOOST2_IO_ZSTD.");
+#endif
+    }else{
+      static_cast<void>(options);
+      return make_binary_file_writer(path);
+    }
+  }
+
+}
+
+
+#endif
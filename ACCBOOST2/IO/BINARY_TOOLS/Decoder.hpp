@@ -2,8 +2,12 @@
 #define ACCBOOST2_IO_BINARY_TOOLS_DECORDER_HPP_
 
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include "Reader.hpp"
+#include "transcode.hpp"
+#include "../trace.hpp"
 
 
 namespace ACCBOOST2::IO::BINARY_TOOLS
@@ -68,121 +72,322 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
     }
 
 
-    template<class BinaryReaderPtrT>
-    class U8DecoderFromAscii: public U8Reader
+    /// buffer[i] から buffer[n - 1] のうち先頭から続く ASCII 文字を 8 バイトずつ読み飛ばし，読み飛ばした後の位置を返す．
+    static inline std::size_t skip_ascii(const char8_t* buffer, std::size_t i, std::size_t n) noexcept
     {
-      static_assert(std::is_same_v<BinaryReaderPtrT, std::unique_ptr<BinaryReader>> || std::is_same_v<BinaryReaderPtrT, std::shared_ptr<BinaryReader>>);
-    private:
+      while(i + 8 <= n){
+        std::uint64_t x;
+        std::memcpy(&x, buffer + i, 8);
+        if(x & 0x8080808080808080ULL) break;
+        i += 8;
+      }
+      return i;
+    }
 
-      BinaryReaderPtrT binary_reader_;
+    static inline bool is_ascii(const char8_t* buffer, std::size_t n) noexcept
+    {
+      for(std::size_t i = skip_ascii(buffer, 0, n); i < n; ++i){
+        if(static_cast<std::uint8_t>(buffer[i]) & 0x80) return false;
+      }
+      return true;
+    }
 
-    public:
 
-      template<class T>
-      explicit U8DecoderFromAscii(T&& binary_reader):
-        binary_reader_(std::forward<T>(binary_reader))
-      {}
+  } // _impl_Decorder
 
-      std::size_t min_buffer_size() const noexcept override
-      {
-        if(binary_reader_ != nullptr){
-          return binary_reader_->min_buffer_size();
-        }else{
-          return 0;
-        }
-      }
 
-      std::size_t operator()(char_type* buffer, std::size_t limit) override
-      {
-        if(binary_reader_ != nullptr){
-          auto n = (*binary_reader_)(reinterpret_cast<std::byte*>(buffer), limit);
-          for(std::size_t i = 0; i < n; ++i){
-            if(static_cast<std::uint8_t>(buffer[i]) & 0x80) throw std::runtime_error("not ascii.");
-          }
-          return n;
+  /**
+   * 静的な BinaryReader から読み込み，ASCII であることを検査して char8_t として返す静的な Reader．
+   * BinaryReaderT を値で持ち，呼び出しは仮想関数を介さないのでインライン化できる．
+   */
+  template<class BinaryReaderT>
+  class AsciiDecoder
+  {
+    static_assert(std::is_same_v<typename BinaryReaderT::char_type, std::byte>);
+
+  public:
+
+    using char_type = char8_t;
+
+  private:
+
+    BinaryReaderT binary_reader_;
+
+  public:
+
+    explicit AsciiDecoder(BinaryReaderT&& binary_reader):
+      binary_reader_(std::move(binary_reader))
+    {}
+
+    AsciiDecoder(AsciiDecoder&&) = default;
+
+    std::size_t min_buffer_size() const noexcept
+    {
+      return binary_reader_.min_buffer_size();
+    }
+
+    std::size_t preferred_buffer_size() const noexcept
+    {
+      return binary_reader_.preferred_buffer_size();
+    }
+
+    std::size_t operator()(char_type* buffer, std::size_t limit)
+    {
+      TraceScope trace(TraceStage::decode);
+      auto n = binary_reader_(reinterpret_cast<std::byte*>(buffer), limit);
+      trace.add_bytes(n);
+      if(!_impl_Decorder::is_ascii(buffer, n)) throw std::runtime_error("not ascii.");
+      return n;
+    }
+
+    void close() noexcept
+    {
+      binary_reader_.close();
+    }
+
+  };
+
+
+  /**
+   * 静的な BinaryReader から読み込み，UTF-8 として正しいことを検査して char8_t として返す静的な Reader．
+   * バッファの末尾で途切れた文字は次の呼び出しに回す．
+   */
+  template<class BinaryReaderT>
+  class UTF8Decoder
+  {
+    static_assert(std::is_same_v<typename BinaryReaderT::char_type, std::byte>);
+
+  public:
+
+    using char_type = char8_t;
+
+  private:
+
+    BinaryReaderT binary_reader_;
+    std::size_t min_buffer_size_;
+    std::size_t frag_size_;
+    char_type frag_buffer_[3];
+
+  public:
+
+    explicit UTF8Decoder(BinaryReaderT&& binary_reader):
+      binary_reader_(std::move(binary_reader)), min_buffer_size_(binary_reader_.min_buffer_size() + 3), frag_size_(0), frag_buffer_()
+    {}
+
+    UTF8Decoder(UTF8Decoder&&) = default;
+
+    std::size_t min_buffer_size() const noexcept
+    {
+      return min_buffer_size_;
+    }
+
+    std::size_t preferred_buffer_size() const noexcept
+    {
+      return std::max(binary_reader_.preferred_buffer_size() + 3, min_buffer_size_);
+    }
+
+    std::size_t operator()(char_type* buffer, std::size_t limit)
+    {
+      assert(limit >= min_buffer_size_);
+      TraceScope trace(TraceStage::decode);
+      // frag_buffer_ の内容を buffer に移動
+      for(std::uint8_t i = 0; i < frag_size_; ++i){
+        buffer[i] = frag_buffer_[i];
+      }
+      // buffer + frag_size_ 以降にデータを書き込み
+      auto m = binary_reader_(reinterpret_cast<std::byte*>(buffer) + frag_size_, limit - frag_size_);
+      // frag_buffer_ から移動した分を含めたバイト数
+      auto n = m + frag_size_;
+      frag_size_ = 0;
+      trace.add_bytes(n);
+      //
+      for(std::size_t i = 0; i < n;){
+        // ASCII の部分は 8 バイトずつ読み飛ばす
+        i = _impl_Decorder::skip_ascii(buffer, i, n);
+        if(i == n) break;
+        auto [is_valid, bytes] = _impl_Decorder::parse_u8char(reinterpret_cast<std::byte*>(buffer + i), n - i);
+        assert(i + bytes <= n);
+        if(is_valid) [[likely]] {
+          assert(bytes >= 1);
+          i += bytes;
         }else{
-          return 0;
+          assert(bytes <= 3);
+          if(i + bytes == n){
+            frag_size_ = bytes;
+            for(std::size_t j = 0; j < bytes; ++j){
+              frag_buffer_[j] = buffer[i + j];
+            }
+            return i;
+          }else{
+            throw std::runtime_error("Invalid encoding");
+          }
         }
       }
+      return n;
+    }
 
-      void close() noexcept override
-      {
-        binary_reader_ = nullptr;
-      }
+    void close() noexcept
+    {
+      binary_reader_.close();
+      min_buffer_size_ = 0;
+      frag_size_ = 0;
+    }
 
-    };
+  };
 
-    template<class BinaryReaderPtrT>
-    class U8DecoderFromUTF8: public U8Reader
-    {
-      static_assert(std::is_same_v<BinaryReaderPtrT, std::unique_ptr<BinaryReader>> || std::is_same_v<BinaryReaderPtrT, std::shared_ptr<BinaryReader>>);
 
-    private:
+  /**
+   * 静的な BinaryReader から From で符号化されたバイト列を読み込み，To で符号化して返す静的な Reader（From, To は _impl_transcode::U8 など）．
+   * 読み込んだバイト列はいったん内部のバッファに置き，末尾で途切れた文字は次の呼び出しに回す．
+   * limit が preferred_buffer_size() 以上ならば buffer に直接変換し，そうでなければ内部のバッファを介して返す．
+   * From がバイト順マークを持つ（UTF-16）場合，入力の先頭にあるバイト順マークは取り除く．
+   */
+  template<class From, class To, class BinaryReaderT>
+  class TranscodingDecoder
+  {
+    static_assert(std::is_same_v<typename BinaryReaderT::char_type, std::byte>);
+    static_assert(sizeof(typename From::unit_type) == 1);
 
-      BinaryReaderPtrT binary_reader_;
-      std::size_t min_buffer_size_;
-      std::size_t frag_size_;
-      char_type frag_buffer_[3];
+  public:
 
-    public:
+    using char_type = typename To::unit_type;
 
-      template<class T>
-      explicit U8DecoderFromUTF8(T&& binary_reader):
-        binary_reader_(std::forward<T>(binary_reader)), min_buffer_size_(binary_reader_->min_buffer_size() + 3), frag_size_(0), frag_buffer_()
-      {}
+  private:
 
-      std::size_t min_buffer_size() const noexcept override
-      {
-        return min_buffer_size_;
-      }
+    BinaryReaderT binary_reader_;
+    std::size_t input_size_;
+    std::unique_ptr<std::byte[]> input_;
+    // input_ に残っている（前回途切れた文字の）バイト数
+    std::size_t frag_size_;
+    std::size_t output_size_;
+    std::unique_ptr<char_type[]> output_;
+    std::size_t output_first_;
+    std::size_t output_last_;
+    // まだ先頭のバイト順マークを調べていない
+    bool at_start_;
 
-      std::size_t operator()(char_type* buffer, std::size_t limit) override
-      {
-        if(binary_reader_ != nullptr){
-          assert(limit >= min_buffer_size_);
-          // frag_buffer_ の内容を buffer に移動
-          for(std::uint8_t i = 0; i < frag_size_; ++i){
-            buffer[i] = frag_buffer_[i];
-          }
-          // buffer + frag_size_ 以降にデータを書き込み
-          auto m = (*binary_reader_)(reinterpret_cast<std::byte*>(buffer) + frag_size_, limit - frag_size_);
-          // frag_buffer_ から移動した分を含めたバイト数
-          auto n = m + frag_size_;
-          frag_size_ = 0;
-          //
-          for(std::size_t i = 0; i < n;){
-            auto [is_valid, bytes] = parse_u8char(reinterpret_cast<std::byte*>(buffer + i), n - i);
-            assert(i + bytes <= n);
-            if(is_valid) [[likely]] {
-              assert(bytes >= 1);
-              i += bytes;
-            }else{
-              assert(bytes <= 3);
-              if(i + bytes == n){
-                frag_size_ = bytes;
-                for(std::size_t j = 0; j < bytes; ++j){
-                  frag_buffer_[j] = buffer[i + j];
-                }
-                return i;
-              }else{
-                throw std::runtime_error("Invalid encoding");
-              }
+    /// 1 文字以上変換できるまで読み込んで out に書き込み，書き込んだ要素数を返す（EOF ならば 0）．
+    std::size_t _decode(char_type* out)
+    {
+      while(1){
+        auto m = binary_reader_(input_.get() + frag_size_, input_size_ - frag_size_);
+        auto n = m + frag_size_;
+        if(m == 0){
+          if(frag_size_ != 0) _impl_transcode::invalid_encoding();
+          return 0;
+        }
+        std::size_t skip = 0;
+        if constexpr (requires{From::byte_order_mark;}){
+          // 先頭のバイト順マークは文字として返さない
+          constexpr std::size_t bom_size = sizeof(From::byte_order_mark);
+          if(at_start_){
+            if(n < bom_size){
+              frag_size_ = n;
+              continue;
+            }
+            at_start_ = false;
+            if(std::memcmp(input_.get(), From::byte_order_mark, bom_size) == 0){
+              skip = bom_size;
             }
           }
-          return n;
-        }else{
-          return 0;
         }
+        auto [read, written] = _impl_transcode::transcode<From, To>(reinterpret_cast<const typename From::unit_type*>(input_.get() + skip), n - skip, out);
+        frag_size_ = n - skip - read;
+        std::memmove(input_.get(), input_.get() + skip + read, frag_size_);
+        if(written != 0) return written;
       }
+    }
+
+  public:
+
+    explicit TranscodingDecoder(BinaryReaderT&& binary_reader):
+      binary_reader_(std::move(binary_reader)),
+      // note: 途切れた文字は最大で 3 バイト
+      input_size_(std::max(binary_reader_.preferred_buffer_size(), binary_reader_.min_buffer_size()) + 3),
+      input_(std::make_unique_for_overwrite<std::byte[]>(input_size_)),
+      frag_size_(0),
+      output_size_(_impl_transcode::max_output_size<From, To>(input_size_)),
+      output_(),
+      output_first_(0),
+      output_last_(0),
+      at_start_(true)
+    {}
 
-      void close() noexcept override
-      {
-        binary_reader_ = nullptr;
-        min_buffer_size_ = 0;
-        frag_size_ = 0;
+    TranscodingDecoder(TranscodingDecoder&&) = default;
+
+    std::size_t min_buffer_size() const noexcept
+    {
+      return 1;
+    }
+
+    std::size_t preferred_buffer_size() const noexcept
+    {
+      return output_size_;
+    }
+
+    std::size_t operator()(char_type* buffer, std::size_t limit)
+    {
+      TraceScope trace(TraceStage::decode);
+      if(output_first_ == output_last_){
+        if(limit >= output_size_){
+          auto n = _decode(buffer);
+          trace.add_bytes(n);
+          return n;
+        }
+        if(output_ == nullptr){
+          output_ = std::make_unique_for_overwrite<char_type[]>(output_size_);
+        }
+        output_first_ = 0;
+        output_last_ = _decode(output_.get());
       }
+      auto n = std::min(limit, output_last_ - output_first_);
+      std::memcpy(buffer, output_.get() + output_first_, n * sizeof(char_type));
+      output_first_ += n;
+      trace.add_bytes(n);
+      return n;
+    }
+
+    void close() noexcept
+    {
+      binary_reader_.close();
+      frag_size_ = 0;
+      output_first_ = 0;
+      output_last_ = 0;
+    }
+
+  };
 
-    };
+  /// UTF-8 のバイト列を char32_t（UTF-32）として読み込む静的な Reader．
+  template<class BinaryReaderT>
+  using UTF8ToUTF32Decoder = TranscodingDecoder<_impl_transcode::U8, _impl_transcode::U32, BinaryReaderT>;
+
+  /// UTF-16LE のバイト列を char8_t（UTF-8）として読み込む静的な Reader．
+  template<class BinaryReaderT>
+  using UTF16LEToUTF8Decoder = TranscodingDecoder<_impl_transcode::U16<std::endian::little>, _impl_transcode::U8, BinaryReaderT>;
+
+  /// UTF-16BE のバイト列を char8_t（UTF-8）として読み込む静的な Reader．
+  template<class BinaryReaderT>
+  using UTF16BEToUTF8Decoder = TranscodingDecoder<_impl_transcode::U16<std::endian::big>, _impl_transcode::U8, BinaryReaderT>;
+
+  /// UTF-16LE のバイト列を char32_t（UTF-32）として読み込む静的な Reader．
+  template<class BinaryReaderT>
+  using UTF16LEToUTF32Decoder = TranscodingDecoder<_impl_transcode::U16<std::endian::little>, _impl_transcode::U32, BinaryReaderT>;
+
+  /// UTF-16BE のバイト列を char32_t（UTF-32）として読み込む静的な Reader．
+  template<class BinaryReaderT>
+  using UTF16BEToUTF32Decoder = TranscodingDecoder<_impl_transcode::U16<std::endian::big>, _impl_transcode::U32, BinaryReaderT>;
+
+
+  namespace _impl_Decorder
+  {
+
+    template<template<class> class DecoderT, class BinaryReaderPtrT>
+    auto make_dynamic_decoder(BinaryReaderPtrT&& binary_reader)
+    {
+      using BinaryReaderT = IndirectReader<std::remove_reference_t<BinaryReaderPtrT>>;
+      using DecoderType = DecoderT<BinaryReaderT>;
+      return std::make_unique<DynamicReader<DecoderType>>(DecoderType(BinaryReaderT(std::forward<BinaryReaderPtrT>(binary_reader))));
+    }
 
     // utf-8 への変換
     template<class CharT, class BinaryReaderPtrT>
@@ -192,21 +397,43 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
     std::unique_ptr<Reader<CharT>> make_decoder_impl(BinaryReaderPtrT&& binary_reader, const std::string& encoding)
     {
       if(encoding == "ascii"){
-        return std::make_unique<U8DecoderFromAscii<std::remove_reference_t<BinaryReaderPtrT>>>(std::forward<BinaryReaderPtrT>(binary_reader));
+        return make_dynamic_decoder<AsciiDecoder>(std::forward<BinaryReaderPtrT>(binary_reader));
       }else if(encoding == "utf-8"){
-        return std::make_unique<U8DecoderFromUTF8<std::remove_reference_t<BinaryReaderPtrT>>>(std::forward<BinaryReaderPtrT>(binary_reader));
+        return make_dynamic_decoder<UTF8Decoder>(std::forward<BinaryReaderPtrT>(binary_reader));
+      }else if(encoding == "utf-16le"){
+        return make_dynamic_decoder<UTF16LEToUTF8Decoder>(std::forward<BinaryReaderPtrT>(binary_reader));
+      }else if(encoding == "utf-16be"){
+        return make_dynamic_decoder<UTF16BEToUTF8Decoder>(std::forward<BinaryReaderPtrT>(binary_reader));
       }else{
         throw std::runtime_error("Decoding from \"" + encoding + "\" is not implemented.");
       }
     }
 
+    // utf-32 への変換
     template<class CharT, class BinaryReaderPtrT>
     requires(
-      !std::is_same_v<CharT, char8_t>
+      std::is_same_v<CharT, char32_t>
     )
     std::unique_ptr<Reader<CharT>> make_decoder_impl(BinaryReaderPtrT&& binary_reader, const std::string& encoding)
     {
-      throw std::runtime_error("Decoding to \"utf-8\" is not implemented.");
+      if(encoding == "utf-8"){
+        return make_dynamic_decoder<UTF8ToUTF32Decoder>(std::forward<BinaryReaderPtrT>(binary_reader));
+      }else if(encoding == "utf-16le"){
+        return make_dynamic_decoder<UTF16LEToUTF32Decoder>(std::forward<BinaryReaderPtrT>(binary_reader));
+      }else if(encoding == "utf-16be"){
+        return make_dynamic_decoder<UTF16BEToUTF32Decoder>(std::forward<BinaryReaderPtrT>(binary_reader));
+      }else{
+        throw std::runtime_error("Decoding from \"" + encoding + "\" is not implemented.");
+      }
+    }
+
+    template<class CharT, class BinaryReaderPtrT>
+    requires(
+      !std::is_same_v<CharT, char8_t> && !std::is_same_v<CharT, char32_t>
+    )
+    std::unique_ptr<Reader<CharT>> make_decoder_impl(BinaryReaderPtrT&&, const std::string& encoding)
+    {
+      throw std::runtime_error("Decoding from \"" + encoding + "\" is not implemented.");
       return nullptr;
     }
 
@@ -0,0 +1,382 @@
+#ifndef ACCBOOST2_IO_BINARY_TOOLS_DECOMPRESSINGREADER_HPP_
+#define ACCBOOST2_IO_BINARY_TOOLS_DECOMPRESSINGREADER_HPP_
+
+
+/**
+ * 圧縮されたファイルを伸長しながら読む BinaryReader．
+ * ACCBOOST2_IO_ZLIB を定義すると gzip（zlib が必要，-lz でリンクする），
+ * ACCBOOST2_IO_ZSTD を定義すると zstd（libzstd が必要，-lzstd でリンクする）に対応する．
+ */
+
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "Reader.hpp"
+#include "ReadAheadReader.hpp"
+#include "../trace.hpp"
+
+#if defined(ACCBOOST2_IO_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(ACCBOOST2_IO_ZSTD)
+#include <zstd.h>
+#endif
+
+
+namespace ACCBOOST2::IO::BINARY_TOOLS
+{
+
+  namespace _impl_DecompressingReader
+  {
+
+    static constexpr std::size_t input_buffer_size = 1 << 16;
+
+    static constexpr std::size_t output_buffer_size = 1 << 18;
+
+    /**
+     * 先頭を読んでおき（マジックナンバーの判定に使う），それを返してから reader の続きを読む BinaryReader．
+     */
+    class PrefixedReader: public BinaryReader
+    {
+    private:
+
+      std::unique_ptr<BinaryReader> reader_;
+      std::unique_ptr<std::byte[]> prefix_;
+      std::size_t first_;
+      std::size_t last_;
+
+    public:
+
+      PrefixedReader(std::unique_ptr<BinaryReader>&& reader, std::size_t prefix_size):
+        reader_(std::move(reader)), prefix_(), first_(0), last_(0)
+      {
+        assert(reader_ != nullptr);
+        const std::size_t capacity = std::max(reader_->min_buffer_size(), prefix_size);
+        prefix_ = std::make_unique_for_overwrite<std::byte[]>(capacity);
+        // note: パイプなどでは 1 回で prefix_size バイトに満たないことがある．
+        while(last_ < prefix_size){
+          auto n = (*reader_)(prefix_.get() + last_, capacity - last_);
+          if(n == 0) break;
+          last_ += n;
+        }
+      }
+
+      ~PrefixedReader() noexcept
+      {
+        close();
+      }
+
+      /// 先頭の（最大で）size バイト．
+      std::basic_string_view<std::byte> prefix(std::size_t size) const noexcept
+      {
+        return {prefix_.get(), std::min(size, last_)};
+      }
+
+      std::size_t min_buffer_size() const noexcept override
+      {
+        return reader_ != nullptr ? reader_->min_buffer_size() : 0;
+      }
+
+      std::size_t preferred_buffer_size() const noexcept override
+      {
+        return reader_ != nullptr ? reader_->preferred_buffer_size() : 0;
+      }
+
+      std::size_t operator()(char_type* buffer, std::size_t limit) override
+      {
+        if(first_ != last_){
+          const std::size_t n = std::min(limit, last_ - first_);
+          std::memcpy(buffer, prefix_.get() + first_, n);
+          first_ += n;
+          if(first_ == last_){
+            prefix_ = nullptr;
+          }
+          return n;
+        }
+        return reader_ != nullptr ? (*reader_)(buffer, limit) : 0;
+      }
+
+      void close() noexcept override
+      {
+        if(reader_ != nullptr){
+          reader_->close();
+          reader_ = nullptr;
+        }
+        prefix_ = nullptr;
+        first_ = 0;
+        last_ = 0;
+      }
+
+    };
+
+
+#if defined(ACCBOOST2_IO_ZLIB)
+
+    /// gzip（または zlib 形式）のストリームを伸長する BinaryReader．連結された複数のメンバーも続けて読む．
+    class GzipReader: public BinaryReader
+    {
+    private:
+
+      std::unique_ptr<BinaryReader> reader_;
+      std::size_t input_size_;
+      std::unique_ptr<std::byte[]> input_;
+      z_stream stream_;
+      // 直前のメンバーを読み終えたか
+      bool member_ended_;
+
+    public:
+
+      explicit GzipReader(std::unique_ptr<BinaryReader>&& reader):
+        reader_(std::move(reader)),
+        input_size_(std::max(reader_->min_buffer_size(), input_buffer_size)),
+        input_(std::make_unique_for_overwrite<std::byte[]>(input_size_)),
+        stream_(),
+        member_ended_(false)
+      {
+        // note: windowBits に 32 を加えると gzip と zlib のヘッダを自動で判別する．
+        if(::inflateInit2(&stream_, 15 + 32) != Z_OK){
+          throw std::runtime_error("inflateInit2() failure.");
+        }
+      }
+
+      ~GzipReader() noexcept
+      {
+        close();
+      }
+
+      std::size_t min_buffer_size() const noexcept override
+      {
+        return 1;
+      }
+
+      std::size_t preferred_buffer_size() const noexcept override
+      {
+        return output_buffer_size;
+      }
+
+      std::size_t operator()(char_type* buffer, std::size_t limit) override
+      {
+        if(reader_ == nullptr) return 0;
+        TraceScope trace(TraceStage::decompress);
+        limit = std::min<std::size_t>(limit, std::numeric_limits<uInt>::max());
+        stream_.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream_.avail_out = static_cast<uInt>(limit);
+        while(stream_.avail_out == limit){
+          if(stream_.avail_in == 0){
+            auto n = (*reader_)(input_.get(), input_size_);
+            if(n == 0){
+              if(!member_ended_) throw std::runtime_error("Truncated gzip stream.");
+              return 0;
+            }
+            stream_.next_in = reinterpret_cast<Bytef*>(input_.get());
+            stream_.avail_in = static_cast<uInt>(n);
+          }
+          if(member_ended_){
+            if(::inflateReset(&stream_) != Z_OK) throw std::runtime_error("inflateReset() failure.");
+            member_ended_ = false;
+          }
+          auto ret = ::inflate(&stream_, Z_NO_FLUSH);
+          if(ret == Z_STREAM_END){
+            member_ended_ = true;
+          }else if(ret != Z_OK){
+            throw std::runtime_error(std::string("inflate() failure: ") + (stream_.msg != nullptr ? stream_.msg : "unknown error") + ".");
+          }
+        }
+        const std::size_t n = limit - stream_.avail_out;
+        trace.add_bytes(n);
+        return n;
+      }
+
+      void close() noexcept override
+      {
+        if(reader_ != nullptr){
+          ::inflateEnd(&stream_);
+          reader_->close();
+          reader_ = nullptr;
+        }
+        input_ = nullptr;
+      }
+
+    // deleted:
+
+      GzipReader(GzipReader&&) = delete;
+      GzipReader(const GzipReader&) = delete;
+      GzipReader& operator=(GzipReader&&) = delete;
+      GzipReader& operator=(const GzipReader&) = delete;
+
+    };
+
+#endif
+
+
+#if defined(ACCBOOST2_IO_ZSTD)
+
+    /// zstd のストリームを伸長する BinaryReader．連結された複数のフレームも続けて読む．
+    class ZstdReader: public BinaryReader
+    {
+    private:
+
+      std::unique_ptr<BinaryReader> reader_;
+      std::size_t input_size_;
+      std::unique_ptr<std::byte[]> input_;
+      ZSTD_DCtx* context_;
+      ZSTD_inBuffer in_;
+      // 直前のフレームを読み終えたか
+      bool frame_ended_;
+
+    public:
+
+      explicit ZstdReader(std::unique_ptr<BinaryReader>&& reader):
+        reader_(std::move(reader)),
+        input_size_(std::max({reader_->min_buffer_size(), input_buffer_size, ::ZSTD_DStreamInSize()})),
+        input_(std::make_unique_for_overwrite<std::byte[]>(input_size_)),
+        context_(::ZSTD_createDCtx()),
+        in_{input_.get(), 0, 0},
+        frame_ended_(false)
+      {
+        if(context_ == nullptr){
+          throw std::runtime_error("ZSTD_createDCtx() failure.");
+        }
+      }
+
+      ~ZstdReader() noexcept
+      {
+        close();
+      }
+
+      std::size_t min_buffer_size() const noexcept override
+      {
+        return 1;
+      }
+
+      std::size_t preferred_buffer_size() const noexcept override
+      {
+        return output_buffer_size;
+      }
+
+      std::size_t operator()(char_type* buffer, std::size_t limit) override
+      {
+        if(reader_ == nullptr) return 0;
+        TraceScope trace(TraceStage::decompress);
+        ZSTD_outBuffer out{buffer, limit, 0};
+        while(out.pos == 0){
+          if(in_.pos == in_.size){
+            auto n = (*reader_)(input_.get(), input_size_);
+            if(n == 0){
+              if(frame_ended_) return 0;
+              // 入力を読み終えても，フレームの終わりまで伸長した出力がまだ残っていることがある．
+              // 空の入力で進まなくなったときだけ途切れているとみなす．
+              in_ = {input_.get(), 0, 0};
+              auto ret = ::ZSTD_decompressStream(context_, &out, &in_);
+              if(::ZSTD_isError(ret)){
+                throw std::runtime_error(std::string("ZSTD_decompressStream() failure: ") + ::ZSTD_getErrorName(ret) + ".");
+              }
+              frame_ended_ = (ret == 0);
+              if(out.pos == 0){
+                if(!frame_ended_) throw std::runtime_error("Truncated zstd stream.");
+                return 0;
+              }
+              break;
+            }
+            in_ = {input_.get(), n, 0};
+          }
+          auto ret = ::ZSTD_decompressStream(context_, &out, &in_);
+          if(::ZSTD_isError(ret)){
+            throw std::runtime_error(std::string("ZSTD_decompressStream() failure: ") + ::ZSTD_getErrorName(ret) + ".");
+          }
+          frame_ended_ = (ret == 0);
+        }
+        trace.add_bytes(out.pos);
+        return out.pos;
+      }
+
+      void close() noexcept override
+      {
+        if(reader_ != nullptr){
+          ::ZSTD_freeDCtx(context_);
+          context_ = nullptr;
+          reader_->close();
+          reader_ = nullptr;
+        }
+        input_ = nullptr;
+      }
+
+    // deleted:
+
+      ZstdReader(ZstdReader&&) = delete;
+      ZstdReader(const ZstdReader&) = delete;
+      ZstdReader& operator=(ZstdReader&&) = delete;
+      ZstdReader& operator=(const ZstdReader&) = delete;
+
+    };
+
+#endif
+
+
+    static inline bool starts_with(std::basic_string_view<std::byte> s, std::initializer_list<unsigned char> magic) noexcept
+    {
+      return s.size() >= magic.size() && std::equal(magic.begin(), magic.end(), s.begin(), [](unsigned char x, std::byte y){return std::byte{x} == y;});
+    }
+
+  }
+
+
+#if defined(ACCBOOST2_IO_ZLIB)
+
+  /// gzip（または zlib 形式）で圧縮された reader を伸長しながら読む BinaryReader を作る．
+  static inline std::unique_ptr<BinaryReader> make_gzip_reader(std::unique_ptr<BinaryReader>&& reader)
+  {
+    return std::make_unique<_impl_DecompressingReader::GzipReader>(std::move(reader));
+  }
+
+#endif
+
+#if defined(ACCBOOST2_IO_ZSTD)
+
+  /// zstd で圧縮された reader を伸長しながら読む BinaryReader を作る．
+  static inline std::unique_ptr<BinaryReader> make_zstd_reader(std::unique_ptr<BinaryReader>&& reader)
+  {
+    return std::make_unique<_impl_DecompressingReader::ZstdReader>(std::move(reader));
+  }
+
+#endif
+
+  /**
+   * reader の先頭のマジックナンバーから gzip または zstd で圧縮されているかを判定し，圧縮されていれば伸長しながら読む BinaryReader を作る．
+   * 圧縮されていなければ reader をそのまま読む．
+   * read_ahead が true ならば伸長を別スレッドで行い（make_read_ahead_reader を参照），呼び出し側の処理と重ねる．
+   * 対応する ACCBOOST2_IO_ZLIB または ACCBOOST2_IO_ZSTD が定義されていない形式ならば例外を投げる．
+   */
+  static inline std::unique_ptr<BinaryReader> make_decompressing_reader(std::unique_ptr<BinaryReader>&& reader, bool read_ahead = true)
+  {
+    using namespace _impl_DecompressingReader;
+    auto prefixed = std::make_unique<PrefixedReader>(std::move(reader), 4);
+    const auto prefix = prefixed->prefix(4);
+    std::unique_ptr<BinaryReader> result;
+    if(starts_with(prefix, {0x1F, 0x8B})){
+#if defined(ACCBOOST2_IO_ZLIB)
+      result = make_gzip_reader(std::move(prefixed));
+#else
+      throw std::runtime_error("Reading gzip-compressed input requires ACCBOOST2_IO_ZLIB.");
+#endif
+    }else if(starts_with(prefix, {0x28, 0xB5, 0x2F, 0xFD})){
+#if defined(ACCBOOST2_IO_ZSTD)
+      result = make_zstd_reader(std::move(prefixed));
+#else
+      throw std::runtime_error("Reading zstd-compressed input requires ACCBOOST2_IO_ZSTD.");
+#endif
+    }else{
+      return prefixed;
+    }
+    return read_ahead ? make_read_ahead_reader(std::move(result)) : std::move(result);
+  }
+
+}
+
+
+#endif
@@ -2,7 +2,13 @@
 #define ACCBOOST2_IO_BINARY_TOOLS_ENCODER_HPP_
 
 
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
 #include "Writer.hpp"
+#include "transcode.hpp"
+#include "../trace.hpp"
 
 
 namespace ACCBOOST2::IO::BINARY_TOOLS
@@ -28,12 +34,29 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
 
     void operator()(const char_type* buffer, std::size_t size) override
     {
+      TraceScope trace(TraceStage::encode);
+      trace.add_bytes(size);
       for(std::size_t i = 0; i < size; ++i){
         if(static_cast<std::uint8_t>(buffer[i]) & 0x80) throw std::runtime_error("not ascii.");
       }
       (*writer_)(reinterpret_cast<const BinaryWriter::char_type*>(buffer), size);
     }
 
+    void flush() override
+    {
+      writer_->flush();
+    }
+
+    void close() override
+    {
+      writer_->close();
+    }
+
+    std::size_t preferred_buffer_size() const noexcept override
+    {
+      return writer_->preferred_buffer_size();
+    }
+
   };
 
 
@@ -55,24 +78,156 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
 
     void operator()(const char_type* buffer, std::size_t size) override
     {
+      TraceScope trace(TraceStage::encode);
+      trace.add_bytes(size);
       (*writer_)(reinterpret_cast<const BinaryWriter::char_type*>(buffer), size);
     }
+
+    void flush() override
+    {
+      writer_->flush();
+    }
+
+    void close() override
+    {
+      writer_->close();
+    }
+
+    std::size_t preferred_buffer_size() const noexcept override
+    {
+      return writer_->preferred_buffer_size();
+    }
+  };
+
+
+  /**
+   * From で符号化された文字列を To で符号化して writer に書き込む Writer（From, To は _impl_transcode::U8 など）．
+   * chunk_size 要素ずつ内部のバッファに変換して書き込み，末尾で途切れた文字は次の呼び出しに回す．
+   */
+  template<class From, class To>
+  class TranscodingEncoder: public Writer<typename From::unit_type>
+  {
+    static_assert(sizeof(typename To::unit_type) == 1);
+
+  public:
+
+    using char_type = typename From::unit_type;
+
+  private:
+
+    static constexpr std::size_t chunk_size = 1 << 14;
+
+    std::unique_ptr<BinaryWriter> writer_;
+    std::unique_ptr<typename To::unit_type[]> output_;
+    std::size_t frag_size_;
+    char_type frag_buffer_[4];
+
+    void _write(std::size_t size)
+    {
+      if(size != 0){
+        (*writer_)(reinterpret_cast<const BinaryWriter::char_type*>(output_.get()), size);
+      }
+    }
+
+  public:
+
+    explicit TranscodingEncoder(std::unique_ptr<BinaryWriter>&& writer):
+      writer_(std::move(writer)),
+      output_(std::make_unique_for_overwrite<typename To::unit_type[]>(_impl_transcode::max_output_size<From, To>(chunk_size))),
+      frag_size_(0),
+      frag_buffer_()
+    {}
+
+    void operator()(const char_type* buffer, std::size_t size) override
+    {
+      TraceScope trace(TraceStage::encode);
+      trace.add_bytes(size);
+      // 前回途切れた文字を 1 要素ずつ補って変換する
+      while(frag_size_ != 0 && size != 0){
+        frag_buffer_[frag_size_++] = *buffer++;
+        --size;
+        auto [read, written] = _impl_transcode::transcode<From, To>(frag_buffer_, frag_size_, output_.get());
+        if(read != 0){
+          assert(read == frag_size_);
+          frag_size_ = 0;
+          _write(written);
+        }
+      }
+      while(size != 0){
+        const std::size_t n = std::min(size, chunk_size);
+        auto [read, written] = _impl_transcode::transcode<From, To>(buffer, n, output_.get());
+        _write(written);
+        if(read != n && n == size){
+          assert(size - read <= 3);
+          frag_size_ = size - read;
+          std::copy(buffer + read, buffer + size, frag_buffer_);
+          break;
+        }
+        buffer += read;
+        size -= read;
+      }
+    }
+
+    void flush() override
+    {
+      writer_->flush();
+    }
+
+    /// 末尾で途切れた文字が残っていれば例外を投げる．
+    void close() override
+    {
+      if(frag_size_ != 0) _impl_transcode::invalid_encoding();
+      writer_->close();
+    }
+
+    std::size_t preferred_buffer_size() const noexcept override
+    {
+      return writer_->preferred_buffer_size();
+    }
+
   };
 
+  /// char32_t（UTF-32）の文字列を UTF-8 で書き込む Writer．
+  using UTF32ToUTF8Encoder = TranscodingEncoder<_impl_transcode::U32, _impl_transcode::U8>;
+
+  /// char8_t（UTF-8）の文字列を UTF-16LE で書き込む Writer．
+  using UTF8ToUTF16LEEncoder = TranscodingEncoder<_impl_transcode::U8, _impl_transcode::U16<std::endian::little>>;
+
+  /// char8_t（UTF-8）の文字列を UTF-16BE で書き込む Writer．
+  using UTF8ToUTF16BEEncoder = TranscodingEncoder<_impl_transcode::U8, _impl_transcode::U16<std::endian::big>>;
+
+  /// char32_t（UTF-32）の文字列を UTF-16LE で書き込む Writer．
+  using UTF32ToUTF16LEEncoder = TranscodingEncoder<_impl_transcode::U32, _impl_transcode::U16<std::endian::little>>;
+
+  /// char32_t（UTF-32）の文字列を UTF-16BE で書き込む Writer．
+  using UTF32ToUTF16BEEncoder = TranscodingEncoder<_impl_transcode::U32, _impl_transcode::U16<std::endian::big>>;
+
 
   template<class CharT>
   std::unique_ptr<Writer<CharT>> make_encoder(std::unique_ptr<BinaryWriter>&& writer, const std::string& encoding)
   {
-    if(encoding == "ascii"){
-      return std::make_unique<EncoderToAscii<CharT>>(std::move(writer));
-    }else if(encoding == "utf-8"){
-      return std::make_unique<EncoderToUTF8<CharT>>(std::move(writer));
-    }else{
-      throw std::runtime_error("not implemented.");
+    if constexpr (std::is_same_v<CharT, char8_t>){
+      if(encoding == "ascii"){
+        return std::make_unique<EncoderToAscii<CharT>>(std::move(writer));
+      }else if(encoding == "utf-8"){
+        return std::make_unique<EncoderToUTF8<CharT>>(std::move(writer));
+      }else if(encoding == "utf-16le"){
+        return std::make_unique<UTF8ToUTF16LEEncoder>(std::move(writer));
+      }else if(encoding == "utf-16be"){
+        return std::make_unique<UTF8ToUTF16BEEncoder>(std::move(writer));
+      }
+    }else if constexpr (std::is_same_v<CharT, char32_t>){
+      if(encoding == "utf-8"){
+        return std::make_unique<UTF32ToUTF8Encoder>(std::move(writer));
+      }else if(encoding == "utf-16le"){
+        return std::make_unique<UTF32ToUTF16LEEncoder>(std::move(writer));
+      }else if(encoding == "utf-16be"){
+        return std::make_unique<UTF32ToUTF16BEEncoder>(std::move(writer));
+      }
     }
+    throw std::runtime_error("not implemented.");
   }
 
-
 }
 
 
@@ -0,0 +1,127 @@
+#ifndef ACCBOOST2_IO_BINARY_TOOLS_MAPPEDFILE_HPP_
+#define ACCBOOST2_IO_BINARY_TOOLS_MAPPEDFILE_HPP_
+
+
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace ACCBOOST2::IO::BINARY_TOOLS
+{
+
+  /**
+   * ファイル全体を読み込み専用でメモリにマップする．
+   * 通常のファイルのみ扱え，パイプなどでは例外を投げる．大きさが 0 のファイルでは data() は nullptr になる．
+   */
+  class MappedFile
+  {
+  public:
+
+    /// 読み方をカーネルに伝える（madvise）．
+    enum class AccessPattern
+    {
+      /// 先頭から順に読む（MADV_SEQUENTIAL）
+      SEQUENTIAL,
+      /// 読む順序を指定しない（複数のスレッドが別々の位置を読む場合など）
+      NORMAL,
+      /// ランダムに読む（MADV_RANDOM）
+      RANDOM
+    };
+
+  private:
+
+    void* data_;
+    std::size_t size_;
+
+  public:
+
+    explicit MappedFile(const std::string& path, AccessPattern access_pattern = AccessPattern::SEQUENTIAL):
+      data_(nullptr), size_(0)
+    {
+      const int fd = ::open(path.c_str(), O_RDONLY);
+      if(fd < 0) throw std::runtime_error("Cannot open \"" + path + "\".");
+      struct stat st;
+      if(::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)){
+        ::close(fd);
+        throw std::runtime_error("Cannot map \"" + path + "\" (not a regular file).");
+      }
+      size_ = static_cast<std::size_t>(st.st_size);
+      if(size_ != 0){
+        data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      }
+      // note: マップした後はファイル記述子を閉じてよい．
+      ::close(fd);
+      if(data_ == MAP_FAILED){
+        data_ = nullptr;
+        size_ = 0;
+        throw std::runtime_error("mmap() failure.");
+      }
+      if(data_ != nullptr && access_pattern != AccessPattern::NORMAL){
+        // note: madvise の失敗は性能にしか影響しないので無視する．
+        ::madvise(data_, size_, access_pattern == AccessPattern::SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM);
+      }
+    }
+
+    MappedFile(MappedFile&& other) noexcept:
+      data_(other.data_), size_(other.size_)
+    {
+      other.data_ = nullptr;
+      other.size_ = 0;
+    }
+
+    ~MappedFile() noexcept
+    {
+      if(data_ != nullptr){
+        auto ret = ::munmap(data_, size_);
+        // note: munmap のエラーはデバッグ時のみ捕捉する．
+        assert(ret == 0); static_cast<void>(ret);
+      }
+    }
+
+    const std::byte* data() const noexcept
+    {
+      return static_cast<const std::byte*>(data_);
+    }
+
+    std::size_t size() const noexcept
+    {
+      return size_;
+    }
+
+    /// ファイルの内容を CharT の列として見る（CharT は 1 バイトの型）．
+    template<class CharT>
+    std::basic_string_view<CharT> view() const noexcept
+    {
+      static_assert(sizeof(CharT) == 1);
+      return {reinterpret_cast<const CharT*>(data_), size_};
+    }
+
+    /// [offset, offset + size) をこれから読むことをカーネルに伝え，先読みさせる．
+    void will_need(std::size_t offset, std::size_t size) const noexcept
+    {
+      if(data_ == nullptr || size == 0) return;
+      const std::size_t page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      const std::size_t first = offset / page_size * page_size;
+      ::madvise(static_cast<char*>(data_) + first, offset + size - first, MADV_WILLNEED);
+    }
+
+  // deleted:
+
+    MappedFile() = delete;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+  };
+
+}
+
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef ACCBOOST2_IO_BINARY_TOOLS_READAHEADREADER_HPP_
+#define ACCBOOST2_IO_BINARY_TOOLS_READAHEADREADER_HPP_
+
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Reader.hpp"
+
+
+namespace ACCBOOST2::IO::BINARY_TOOLS
+{
+
+  namespace _impl_ReadAheadReader
+  {
+
+    /**
+     * 別スレッドで reader から先読みする BinaryReader．
+     * 大きさ buffer_size のバッファを number_of_buffers 個の環状バッファとして持ち，
+     * 読み込み側のスレッドは空いているバッファを順に埋め，operator() は埋まったバッファから順にコピーして返す．
+     * これにより，呼び出し側の処理（デコードや解析）と read システムコールが重なる．
+     */
+    class ReadAheadReader: public BinaryReader
+    {
+    private:
+
+      struct Block
+      {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+      };
+
+      std::unique_ptr<BinaryReader> reader_;
+      std::size_t min_buffer_size_;
+      std::size_t preferred_buffer_size_;
+      std::size_t buffer_size_;
+      std::vector<Block> blocks_;
+      // 呼び出し側が次に読むバッファの番号と，その中での位置
+      std::size_t head_;
+      std::size_t position_;
+      // 埋まっているバッファの数（EOF を表す空のバッファを含む）
+      std::size_t number_of_filled_;
+      bool closing_;
+      std::exception_ptr error_;
+      std::mutex mutex_;
+      std::condition_variable filled_;
+      std::condition_variable emptied_;
+      std::thread thread_;
+
+      void run() noexcept
+      {
+        std::size_t tail = 0;
+        while(1){
+          {
+            std::unique_lock<std::mutex> lock(mutex_);
+            emptied_.wait(lock, [&]{return closing_ || number_of_filled_ < blocks_.size();});
+            if(closing_) return;
+          }
+          // note: 埋まっていないバッファには読み込み側のスレッドしか触れないので，ロックせずに書き込む．
+          Block& block = blocks_[tail];
+          std::size_t n = 0;
+          std::exception_ptr error;
+          try{
+            n = (*reader_)(block.data.get(), buffer_size_);
+          }catch(...){
+            error = std::current_exception();
+          }
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(error != nullptr){
+              error_ = error;
+            }else{
+              block.size = n;
+              ++number_of_filled_;
+            }
+          }
+          filled_.notify_one();
+          if(error != nullptr || n == 0) return;
+          tail = (tail + 1) % blocks_.size();
+        }
+      }
+
+    public:
+
+      ReadAheadReader(std::unique_ptr<BinaryReader>&& reader, std::size_t number_of_buffers, std::size_t buffer_size):
+        reader_(std::move(reader)),
+        min_buffer_size_(reader_ != nullptr ? reader_->min_buffer_size() : 0),
+        preferred_buffer_size_(reader_ != nullptr ? reader_->preferred_buffer_size() : 0),
+        buffer_size_(std::max(buffer_size, min_buffer_size_)),
+        blocks_(),
+        head_(0), position_(0), number_of_filled_(0), closing_(false), error_(), mutex_(), filled_(), emptied_(), thread_()
+      {
+        assert(number_of_buffers >= 1);
+        if(reader_ == nullptr){
+          closing_ = true;
+          return;
+        }
+        blocks_.resize(std::max<std::size_t>(number_of_buffers, 1));
+        for(auto& block: blocks_){
+          block.data = std::make_unique_for_overwrite<std::byte[]>(buffer_size_);
+        }
+        thread_ = std::thread([this]{run();});
+      }
+
+      ~ReadAheadReader() noexcept
+      {
+        close();
+      }
+
+      std::size_t min_buffer_size() const noexcept override
+      {
+        return min_buffer_size_;
+      }
+
+      std::size_t preferred_buffer_size() const noexcept override
+      {
+        return preferred_buffer_size_;
+      }
+
+      std::size_t operator()(char_type* buffer, std::size_t limit) override
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        filled_.wait(lock, [&]{return number_of_filled_ != 0 || error_ != nullptr || closing_;});
+        if(number_of_filled_ == 0){
+          if(error_ != nullptr) std::rethrow_exception(error_);
+          return 0;
+        }
+        Block& block = blocks_[head_];
+        if(block.size == 0){
+          // EOF（バッファは解放せず，以降も 0 を返す）
+          return 0;
+        }
+        lock.unlock();
+        // note: 埋まっているバッファには呼び出し側しか触れないので，ロックせずに読む．
+        const std::size_t n = std::min(limit, block.size - position_);
+        std::memcpy(buffer, block.data.get() + position_, n);
+        position_ += n;
+        if(position_ == block.size){
+          position_ = 0;
+          head_ = (head_ + 1) % blocks_.size();
+          lock.lock();
+          --number_of_filled_;
+          lock.unlock();
+          emptied_.notify_one();
+        }
+        return n;
+      }
+
+      /// 読み込み側のスレッドを止めてから reader を閉じる．読み込み中の read システムコールが戻るまで待つ．
+      void close() noexcept override
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          closing_ = true;
+        }
+        emptied_.notify_one();
+        if(thread_.joinable()){
+          thread_.join();
+        }
+        if(reader_ != nullptr){
+          reader_->close();
+          reader_ = nullptr;
+        }
+        blocks_.clear();
+        number_of_filled_ = 0;
+      }
+
+    // deleted:
+
+      ReadAheadReader(ReadAheadReader&&) = delete;
+      ReadAheadReader(const ReadAheadReader&) = delete;
+      ReadAheadReader& operator=(ReadAheadReader&&) = delete;
+      ReadAheadReader& operator=(const ReadAheadReader&) = delete;
+
+    };
+
+  }
+
+
+  /**
+   * reader から別スレッドで先読みする BinaryReader を作る．
+   * 大きさ buffer_size（reader の min_buffer_size() 未満なら切り上げ）のバッファを最大 number_of_buffers 個まで先に埋めておく．
+   */
+  static inline std::unique_ptr<BinaryReader> make_read_ahead_reader(std::unique_ptr<BinaryReader>&& reader, std::size_t number_of_buffers = 4, std::size_t buffer_size = 1 << 20)
+  {
+    return std::make_unique<_impl_ReadAheadReader::ReadAheadReader>(std::move(reader), number_of_buffers, buffer_size);
+  }
+
+}
+
+
+#endif
@@ -22,6 +22,12 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
     virtual ~Reader() = default;
 
     virtual std::size_t min_buffer_size() const noexcept = 0;
+
+    /// 読み込み先のバッファの大きさの推奨値（既定では min_buffer_size()）．
+    virtual std::size_t preferred_buffer_size() const noexcept
+    {
+      return min_buffer_size();
+    }
   
     virtual std::size_t operator()(char_type* buffer, std::size_t limit) = 0;
 
@@ -34,6 +40,95 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
   using U8Reader = Reader<char8_t>;
   using U32Reader = Reader<char32_t>;
 
+
+  /**
+   * Reader へのポインタ（std::unique_ptr または std::shared_ptr）を，仮想関数を介して呼び出す静的な Reader として扱う．
+   * 静的な Reader は Reader と同じメンバ関数を持つが Reader を継承せず，テンプレート引数として組み合わせて使う．
+   */
+  template<class ReaderPtrT>
+  class IndirectReader
+  {
+  public:
+
+    using char_type = typename std::pointer_traits<ReaderPtrT>::element_type::char_type;
+
+  private:
+
+    ReaderPtrT reader_;
+
+  public:
+
+    template<class T>
+    explicit IndirectReader(T&& reader):
+      reader_(std::forward<T>(reader))
+    {}
+
+    IndirectReader(IndirectReader&&) = default;
+
+    std::size_t min_buffer_size() const noexcept
+    {
+      return reader_ != nullptr ? reader_->min_buffer_size() : 0;
+    }
+
+    std::size_t preferred_buffer_size() const noexcept
+    {
+      return reader_ != nullptr ? reader_->preferred_buffer_size() : 0;
+    }
+
+    std::size_t operator()(char_type* buffer, std::size_t limit)
+    {
+      return reader_ != nullptr ? (*reader_)(buffer, limit) : 0;
+    }
+
+    /// ポインタを手放す（std::shared_ptr の場合，共有している Reader は閉じない）．
+    void close() noexcept
+    {
+      reader_ = nullptr;
+    }
+
+  };
+
+
+  /// 静的な Reader を，仮想関数で呼び出される Reader として扱う．
+  template<class StaticReaderT>
+  class DynamicReader final: public Reader<typename StaticReaderT::char_type>
+  {
+  public:
+
+    using char_type = typename StaticReaderT::char_type;
+
+  private:
+
+    StaticReaderT reader_;
+
+  public:
+
+    explicit DynamicReader(StaticReaderT&& reader):
+      reader_(std::move(reader))
+    {}
+
+    std::size_t min_buffer_size() const noexcept override
+    {
+      return reader_.min_buffer_size();
+    }
+
+    std::size_t preferred_buffer_size() const noexcept override
+    {
+      return reader_.preferred_buffer_size();
+    }
+
+    std::size_t operator()(char_type* buffer, std::size_t limit) override
+    {
+      return reader_(buffer, limit);
+    }
+
+    void close() noexcept override
+    {
+      reader_.close();
+    }
+
+  };
+
 }
 
 #endif
@@ -23,6 +23,25 @@ namespace ACCBOOST2::IO::BINARY_TOOLS
 
     virtual void operator()(const char_type* buffer, std::size_t size) = 0;
 
+    /// 一度の operator() で渡す要素数の推奨値（0 ならば指定なし）．
+    virtual std::size_t preferred_buffer_size() const noexcept
+    {
+      return 0;
+    }
+
+    /// これまでに渡したデータを下層の Writer まで書き出す（既定では何もしない）．
+    virtual void flush()
+    {}
+
+    /**
+     * 書き込みを終え，圧縮ストリームの終端なども含めて下層の Writer まで書き出す（既定では flush() を呼ぶ）．
+     * デストラクタと異なり，書き込みのエラーは例外として投げる．close() の後は書き込めない．
+     */
+    virtual void close()
+    {
+      flush();
+    }
+
   protected:
 
     Writer() = default;
@@ -0,0 +1,300 @@
+#ifndef ACCBOOST2_IO_BINARY_TOOLS_TRANSCODE_HPP_
+#define ACCBOOST2_IO_BINARY_TOOLS_TRANSCODE_HPP_
+
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace ACCBOOST2::IO::BINARY_TOOLS
+{
+
+  namespace _impl_transcode
+  {
+
+    /**
+     * 文字コードの規約．
+     * unit_type は符号化された列の要素の型で，size_of_class[k] は次の各種類の文字 1 つを符号化したときの要素数：
+     * k = 0: U+0000..U+007F, 1: U+0080..U+07FF, 2: U+0800..U+FFFF, 3: U+10000..U+10FFFF．
+     * decode は先頭の 1 文字を読んで読んだ要素数を返し（列が途中で終わっている場合は 0），不正な列ならば例外を投げる．
+     * is_ascii_block は先頭の 8 文字分の要素が全て ASCII 文字であるかを判定する（8 文字分の要素があることを仮定する）．
+     */
+
+    [[noreturn]] static inline void invalid_encoding()
+    {
+      throw std::runtime_error("Invalid encoding");
+    }
+
+    static inline bool is_valid_code_point(char32_t c) noexcept
+    {
+      return c <= 0x10FFFF && !(0xD800 <= c && c <= 0xDFFF);
+    }
+
+    /// UTF-8
+    struct U8
+    {
+      using unit_type = char8_t;
+
+      static constexpr std::size_t size_of_class[4] = {1, 2, 3, 4};
+
+      static bool is_ascii_block(const unit_type* s) noexcept
+      {
+        std::uint64_t x;
+        std::memcpy(&x, s, 8);
+        return (x & 0x8080808080808080ULL) == 0;
+      }
+
+      static char32_t get_ascii(const unit_type* s, std::size_t i) noexcept
+      {
+        return s[i];
+      }
+
+      static void put_ascii(unit_type* out, std::size_t i, char32_t c) noexcept
+      {
+        out[i] = static_cast<unit_type>(c);
+      }
+
+      static std::size_t decode(const unit_type* s, std::size_t n, char32_t& c)
+      {
+        const std::uint8_t b0 = static_cast<std::uint8_t>(s[0]);
+        if(b0 < 0x80){
+          c = b0;
+          return 1;
+        }
+        std::size_t length;
+        char32_t min;
+        if((b0 & 0xE0) == 0xC0){
+          length = 2; c = b0 & 0x1F; min = 0x80;
+        }else if((b0 & 0xF0) == 0xE0){
+          length = 3; c = b0 & 0x0F; min = 0x800;
+        }else if((b0 & 0xF8) == 0xF0){
+          length = 4; c = b0 & 0x07; min = 0x10000;
+        }else{
+          invalid_encoding();
+        }
+        for(std::size_t k = 1; k < length; ++k){
+          if(k >= n) return 0;
+          const std::uint8_t b = static_cast<std::uint8_t>(s[k]);
+          if((b & 0xC0) != 0x80) invalid_encoding();
+          c = (c << 6) | (b & 0x3F);
+        }
+        if(c < min || !is_valid_code_point(c)) invalid_encoding();
+        return length;
+      }
+
+      static std::size_t encode(char32_t c, unit_type* out) noexcept
+      {
+        if(c < 0x80){
+          out[0] = static_cast<unit_type>(c);
+          return 1;
+        }else if(c < 0x800){
+          out[0] = static_cast<unit_type>(0xC0 | (c >> 6));
+          out[1] = static_cast<unit_type>(0x80 | (c & 0x3F));
+          return 2;
+        }else if(c < 0x10000){
+          out[0] = static_cast<unit_type>(0xE0 | (c >> 12));
+          out[1] = static_cast<unit_type>(0x80 | ((c >> 6) & 0x3F));
+          out[2] = static_cast<unit_type>(0x80 | (c & 0x3F));
+          return 3;
+        }else{
+          out[0] = static_cast<unit_type>(0xF0 | (c >> 18));
+          out[1] = static_cast<unit_type>(0x80 | ((c >> 12) & 0x3F));
+          out[2] = static_cast<unit_type>(0x80 | ((c >> 6) & 0x3F));
+          out[3] = static_cast<unit_type>(0x80 | (c & 0x3F));
+          return 4;
+        }
+      }
+
+    };
+
+    /// UTF-16（バイト列として扱い，Endian でバイト順を指定する）
+    template<std::endian Endian>
+    struct U16
+    {
+      using unit_type = std::byte;
+
+      static constexpr std::size_t size_of_class[4] = {2, 2, 2, 4};
+
+      /// 先頭にあれば読み込み時に取り除くバイト順マーク（U+FEFF）．
+      static constexpr std::byte byte_order_mark[2] = {
+        std::byte{Endian == std::endian::little ? 0xFF : 0xFE},
+        std::byte{Endian == std::endian::little ? 0xFE : 0xFF}
+      };
+
+      static char16_t load(const unit_type* s) noexcept
+      {
+        const auto b0 = static_cast<std::uint8_t>(s[0]);
+        const auto b1 = static_cast<std::uint8_t>(s[1]);
+        if constexpr (Endian == std::endian::little){
+          return static_cast<char16_t>(b0 | (b1 << 8));
+        }else{
+          return static_cast<char16_t>((b0 << 8) | b1);
+        }
+      }
+
+      static void store(unit_type* out, char16_t u) noexcept
+      {
+        if constexpr (Endian == std::endian::little){
+          out[0] = static_cast<unit_type>(u & 0xFF);
+          out[1] = static_cast<unit_type>(u >> 8);
+        }else{
+          out[0] = static_cast<unit_type>(u >> 8);
+          out[1] = static_cast<unit_type>(u & 0xFF);
+        }
+      }
+
+      static bool is_ascii_block(const unit_type* s) noexcept
+      {
+        // 各要素の上位バイトが 0 かつ下位バイトの最上位ビットが 0
+        // note: 8 バイトをこの計算機のバイト順で読むので，Endian が一致すれば各要素は 0xFF80 で，異なれば 0x80FF で検査する．
+        constexpr std::uint64_t mask = Endian == std::endian::native ? 0xFF80FF80FF80FF80ULL : 0x80FF80FF80FF80FFULL;
+        std::uint64_t x[2];
+        std::memcpy(x, s, 16);
+        return ((x[0] | x[1]) & mask) == 0;
+      }
+
+      static char32_t get_ascii(const unit_type* s, std::size_t i) noexcept
+      {
+        return static_cast<char32_t>(s[Endian == std::endian::little ? 2 * i : 2 * i + 1]);
+      }
+
+      static void put_ascii(unit_type* out, std::size_t i, char32_t c) noexcept
+      {
+        store(out + 2 * i, static_cast<char16_t>(c));
+      }
+
+      static std::size_t decode(const unit_type* s, std::size_t n, char32_t& c)
+      {
+        if(n < 2) return 0;
+        const char16_t u = load(s);
+        if(u < 0xD800 || u >= 0xE000){
+          c = u;
+          return 2;
+        }
+        if(u >= 0xDC00) invalid_encoding();
+        if(n < 4) return 0;
+        const char16_t v = load(s + 2);
+        if(v < 0xDC00 || v >= 0xE000) invalid_encoding();
+        c = 0x10000 + ((static_cast<char32_t>(u) - 0xD800) << 10) + (static_cast<char32_t>(v) - 0xDC00);
+        return 4;
+      }
+
+      static std::size_t encode(char32_t c, unit_type* out) noexcept
+      {
+        if(c < 0x10000){
+          store(out, static_cast<char16_t>(c));
+          return 2;
+        }else{
+          c -= 0x10000;
+          store(out, static_cast<char16_t>(0xD800 + (c >> 10)));
+          store(out + 2, static_cast<char16_t>(0xDC00 + (c & 0x3FF)));
+          return 4;
+        }
+      }
+
+    };
+
+    /// UTF-32（char32_t の列）
+    struct U32
+    {
+      using unit_type = char32_t;
+
+      static constexpr std::size_t size_of_class[4] = {1, 1, 1, 1};
+
+      static bool is_ascii_block(const unit_type* s) noexcept
+      {
+        char32_t x = 0;
+        for(std::size_t k = 0; k < 8; ++k){
+          x |= s[k];
+        }
+        return x < 0x80;
+      }
+
+      static char32_t get_ascii(const unit_type* s, std::size_t i) noexcept
+      {
+        return s[i];
+      }
+
+      static void put_ascii(unit_type* out, std::size_t i, char32_t c) noexcept
+      {
+        out[i] = c;
+      }
+
+      static std::size_t decode(const unit_type* s, std::size_t, char32_t& c)
+      {
+        c = s[0];
+        if(!is_valid_code_point(c)) invalid_encoding();
+        return 1;
+      }
+
+      static std::size_t encode(char32_t c, unit_type* out) noexcept
+      {
+        out[0] = c;
+        return 1;
+      }
+
+    };
+
+    /// From で符号化された n 要素を To で符号化したときの要素数の上限．
+    template<class From, class To>
+    constexpr std::size_t max_output_size(std::size_t n) noexcept
+    {
+      std::size_t result = 0;
+      for(std::size_t k = 0; k < 4; ++k){
+        result = std::max(result, (n / From::size_of_class[k] + 1) * To::size_of_class[k]);
+      }
+      return result;
+    }
+
+    /// 変換で読んだ要素数と書いた要素数．
+    struct Result
+    {
+      std::size_t read;
+      std::size_t written;
+    };
+
+    /**
+     * From で符号化された s[0], ..., s[n - 1] を To で符号化して out に書き込む．
+     * out には max_output_size<From, To>(n) 要素の領域が必要．
+     * 末尾で途切れた文字は読まずに残し，不正な列があれば例外を投げる．
+     * FastPath が true ならば，ASCII 文字が続く部分は 8 文字ずつまとめて変換する（長さが固定のループなのでコンパイラがベクトル化できる）．
+     * ASCII 以外の文字が続く部分では 1 文字ずつ変換し，ASCII 文字が現れるまでブロックの判定をしない．
+     */
+    template<class From, class To, bool FastPath = true>
+    Result transcode(const typename From::unit_type* s, std::size_t n, typename To::unit_type* out)
+    {
+      constexpr std::size_t block = 8;
+      std::size_t i = 0;
+      std::size_t j = 0;
+      while(i < n){
+        if constexpr (FastPath){
+          while(n - i >= block * From::size_of_class[0] && From::is_ascii_block(s + i)){
+            for(std::size_t t = 0; t < block; ++t){
+              To::put_ascii(out + j, t, From::get_ascii(s + i, t));
+            }
+            i += block * From::size_of_class[0];
+            j += block * To::size_of_class[0];
+          }
+          if(i == n) break;
+        }
+        char32_t c;
+        do{
+          const std::size_t m = From::decode(s + i, n - i, c);
+          if(m == 0) return {i, j};
+          i += m;
+          j += To::encode(c, out + j);
+        }while(i < n && (!FastPath || c >= 0x80));
+      }
+      return {i, j};
+    }
+
+  }
+
+}
+
+
+#endif
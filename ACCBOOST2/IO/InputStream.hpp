@@ -3,26 +3,41 @@
 
 
 #include <cassert>
+#include <string_view>
+#include <type_traits>
 #include "BINARY_TOOLS/Reader.hpp"
+#include "trace.hpp"
+#include "../utility/misc/INLINE.hpp"
 
 
 namespace ACCBOOST2::IO
 {
 
-  template<class CharT>
+  /**
+   * ReaderT が抽象クラス（既定の BINARY_TOOLS::Reader<CharT>）ならば std::unique_ptr で持ち，仮想関数を介して読み込む．
+   * 静的な Reader（BINARY_TOOLS::UTF8Decoder<BINARY_TOOLS::FileReader> など）ならば値で持ち，読み込みをインライン化できる．
+   */
+  template<class CharT, class ReaderT = BINARY_TOOLS::Reader<CharT>>
   class InputStream
   {
+    static_assert(std::is_same_v<typename ReaderT::char_type, CharT>);
+
   public:
 
     using char_type = CharT;
+    using reader_type = ReaderT;
 
   private:
 
+    static constexpr bool is_type_erased = std::is_abstract_v<ReaderT>;
+
+    using ReaderHolder = std::conditional_t<is_type_erased, std::unique_ptr<ReaderT>, ReaderT>;
+
     static constexpr std::size_t default_min_buffer_size = 1024;
   
     // note: InputStream がローカル変数ではない状況を加味するとfirst_, last_ は Iterator に持たせたほうがパフォーマンス的にいいかもしれないが，
     // EOF まで読まずにイテレータを破棄した際にイテレータの状態を InputStream に戻すのが面倒．
-    std::unique_ptr<BINARY_TOOLS::Reader<char_type>> reader_;
+    ReaderHolder reader_;
     std::size_t buffer_size_;
     std::unique_ptr<char_type[]> buffer_;
     const char_type* first_;
@@ -30,28 +45,65 @@ namespace ACCBOOST2::IO
 
   public:
 
-    explicit InputStream(std::unique_ptr<BINARY_TOOLS::Reader<char_type>>&& reader):
+    /**
+     * buffer_size はバッファの要素数で，reader の min_buffer_size() 未満ならば切り上げる．
+     * 0 ならば reader の preferred_buffer_size()（読み込むファイルの種類や大きさに応じて決まる）とする．
+     */
+    explicit InputStream(ReaderHolder&& reader, std::size_t buffer_size = 0):
       reader_(std::move(reader)), buffer_size_(0), buffer_(), first_(nullptr), last_(nullptr)
     {
-      if(reader_ != nullptr){
-        buffer_size_ = std::max(reader_->min_buffer_size(), default_min_buffer_size);
-        buffer_ = std::make_unique<char_type[]>(buffer_size_);
-        auto n = (*reader_)(buffer_.get(), buffer_size_);
-        first_ = buffer_.get();
-        last_ = first_ + n;      
+      if(_has_reader()){
+        if(buffer_size == 0){
+          buffer_size = std::max(_reader().preferred_buffer_size(), default_min_buffer_size);
+        }
+        buffer_size_ = std::max(_reader().min_buffer_size(), buffer_size);
+        buffer_ = std::make_unique_for_overwrite<char_type[]>(buffer_size_);
+        _refill();
       }
     }
 
     InputStream(InputStream&& other) noexcept:
       reader_(std::move(other.reader_)), buffer_size_(other.buffer_size_), buffer_(std::move(other.buffer_)), first_(other.first_), last_(other.last_)
     {
-      assert(other.reader_ == nullptr);
+      assert(!is_type_erased || !other._has_reader());
       assert(other.buffer_ == nullptr);
       other.buffer_size_ = 0;
       other.first_ = nullptr;
       other.last_ = nullptr;
     }
 
+  private:
+
+    bool _has_reader() const noexcept
+    {
+      if constexpr (is_type_erased){
+        return reader_ != nullptr;
+      }else{
+        return true;
+      }
+    }
+
+    ReaderT& _reader() noexcept
+    {
+      if constexpr (is_type_erased){
+        return *reader_;
+      }else{
+        return reader_;
+      }
+    }
+
+    // note: 読み込みとデコードがインライン化されると 1 文字ずつ進める処理が肥大化するので，インライン展開しない．
+    ACCBOOST2_NOINLINE void _refill()
+    {
+      TraceScope trace(TraceStage::refill);
+      auto n = _reader()(buffer_.get(), buffer_size_);
+      trace.add_bytes(n);
+      first_ = buffer_.get();
+      last_ = first_ + n;
+    }
+
+  public:
+
     std::size_t buffer_size() const noexcept
     {
       return buffer_size_;
@@ -73,9 +125,23 @@ namespace ACCBOOST2::IO
       assert(!eof());
       ++first_;
       if(first_ == last_){
-        auto n = (*reader_)(buffer_.get(), buffer_size_);
-        first_ = buffer_.get();
-        last_ = first_ + n;      
+        _refill();
+      }
+    }
+
+    /// バッファに読み込まれていてまだ読んでいない部分．eof() でなければ空ではない．
+    std::basic_string_view<char_type> buffered() const noexcept
+    {
+      return {first_, static_cast<std::size_t>(last_ - first_)};
+    }
+
+    /// n 文字（buffered().size() 以下）まとめて読み進める．
+    void skip(std::size_t n)
+    {
+      assert(n <= static_cast<std::size_t>(last_ - first_));
+      first_ += n;
+      if(first_ == last_ && n != 0){
+        _refill();
       }
     }
 
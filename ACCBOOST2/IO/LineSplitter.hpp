@@ -0,0 +1,253 @@
+#ifndef ACCBOOST2_IO_LINESPLITTER_HPP_
+#define ACCBOOST2_IO_LINESPLITTER_HPP_
+
+
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "trace.hpp"
+
+
+namespace ACCBOOST2::IO
+{
+
+  /// LineSplitter が返す行．
+  template<class CharT>
+  struct Line
+  {
+    /// 行の番号（1 から数える）
+    std::size_t number;
+    /// 行の内容（末尾の "\n" または "\r\n" を含まない．次の行に進むまで有効）
+    std::basic_string_view<CharT> value;
+  };
+
+
+  /**
+   * 入力を改行 '\n' で分けて Line を 1 つずつ返す．行末の "\r\n" の '\r' も取り除く．
+   * InputStream（buffered() と skip() を持つもの）や連続した文字列からは改行を memchr でまとめて探し，
+   * 行の内容はバッファを指す std::basic_string_view として返すので，行ごとのコピーはしない．
+   * バッファの境界をまたぐ行だけは内部のバッファにつなげてから返す．
+   */
+  template<class InputStreamType, class CharT>
+  class LineSplitter
+  {
+  public:
+
+    using char_type = CharT;
+
+  private:
+
+    static constexpr char_type _newline = char_type('\n');
+
+    static constexpr bool _is_buffered = requires(InputStreamType& x){x.buffered(); x.skip(std::size_t());};
+
+    InputStreamType _input_stream;
+    std::remove_cv_t<std::remove_reference_t<decltype(std::declval<InputStreamType&>().begin())>> _first;
+    std::remove_cv_t<std::remove_reference_t<decltype(std::declval<InputStreamType&>().end())>> _last;
+    // バッファの境界をまたぐ行をつなげる
+    std::basic_string<char_type> _buffer;
+    Line<char_type> _line;
+    // 返した行（と改行）の文字数．返した行がバッファを指しているので，次の行に進むときに読み進める．
+    std::size_t _consumed;
+    bool _eof;
+
+  public:
+
+    explicit LineSplitter(InputStreamType&& input_stream):
+      _input_stream(std::forward<InputStreamType>(input_stream)),
+      _first(_input_stream.begin()), _last(_input_stream.end()), _buffer(), _line{0, {}}, _consumed(0), _eof(false)
+    {
+      next();
+    }
+
+    LineSplitter(LineSplitter&&) = default;
+
+  private:
+
+    /// [first, last) で最初の改行の位置．なければ last．
+    static const char_type* _find_newline(const char_type* first, const char_type* last) noexcept
+    {
+      if(first == last) return last;
+      const char_type* p;
+      if constexpr (sizeof(char_type) == 1){
+        p = static_cast<const char_type*>(std::memchr(first, '\n', static_cast<std::size_t>(last - first)));
+      }else{
+        p = std::char_traits<char_type>::find(first, static_cast<std::size_t>(last - first), _newline);
+      }
+      return p != nullptr ? p : last;
+    }
+
+    /// 次の行を _line.value に置く．EOF ならば false を返す．
+    bool _read_line()
+    {
+      if constexpr (_is_buffered){
+        _input_stream.skip(_consumed);
+        _consumed = 0;
+        _buffer.clear();
+        while(!_input_stream.eof()){
+          const auto view = _input_stream.buffered();
+          const char_type* p = _find_newline(view.data(), view.data() + view.size());
+          const auto n = static_cast<std::size_t>(p - view.data());
+          if(p != view.data() + view.size()){
+            if(_buffer.empty()){
+              _line.value = view.substr(0, n);
+            }else{
+              _buffer.append(view.data(), n);
+              _line.value = _buffer;
+            }
+            _consumed = n + 1;
+            return true;
+          }
+          _buffer.append(view.data(), n);
+          _input_stream.skip(n);
+        }
+        _line.value = _buffer;
+        return !_buffer.empty();
+      }else if constexpr (std::contiguous_iterator<decltype(_first)>){
+        if(_first == _last) return false;
+        const char_type* first = std::to_address(_first);
+        const char_type* p = _find_newline(first, first + (_last - _first));
+        const auto n = static_cast<std::size_t>(p - first);
+        _line.value = std::basic_string_view<char_type>(first, n);
+        _first += (n != static_cast<std::size_t>(_last - _first) ? n + 1 : n);
+        return true;
+      }else{
+        if(_first == _last) return false;
+        _buffer.clear();
+        while(_first != _last){
+          const char_type c = *_first;
+          ++_first;
+          if(c == _newline) break;
+          _buffer.push_back(c);
+        }
+        _line.value = _buffer;
+        return true;
+      }
+    }
+
+  public:
+
+    bool eof() const noexcept
+    {
+      return _eof;
+    }
+
+    const Line<char_type>& get() const noexcept
+    {
+      assert(!eof());
+      return _line;
+    }
+
+    void next()
+    {
+      TraceScope trace(TraceStage::split);
+      if(!_read_line()){
+        _line.value = {};
+        _eof = true;
+        return;
+      }
+      ++_line.number;
+      if(!_line.value.empty() && _line.value.back() == char_type('\r')){
+        _line.value.remove_suffix(1);
+      }
+      trace.add_bytes(_line.value.size());
+    }
+
+    class Sentinel;
+
+    class Iterator
+    {
+    public:
+
+      using iterator_category = std::input_iterator_tag;
+      using difference_type = std::ptrdiff_t;
+      using value_type = Line<char_type>;
+      using reference = const Line<char_type>&;
+      using pointer = const Line<char_type>*;
+
+    private:
+
+      LineSplitter* _splitter = nullptr;
+
+    public:
+
+      Iterator() = default;
+      Iterator(Iterator&&) = default;
+      Iterator(const Iterator&) = default;
+      Iterator& operator=(Iterator&&) = default;
+      Iterator& operator=(const Iterator&) = default;
+
+      explicit Iterator(LineSplitter& splitter) noexcept:
+        _splitter(std::addressof(splitter))
+      {}
+
+      bool operator==(const Sentinel&) const noexcept
+      {
+        return _splitter->eof();
+      }
+
+      bool operator!=(const Sentinel&) const noexcept
+      {
+        return !_splitter->eof();
+      }
+
+      const Line<char_type>& operator*() const noexcept
+      {
+        return _splitter->get();
+      }
+
+      const Line<char_type>* operator->() const noexcept
+      {
+        return std::addressof(_splitter->get());
+      }
+
+      Iterator& operator++()
+      {
+        _splitter->next();
+        return *this;
+      }
+
+    };
+
+    class Sentinel
+    {
+    public:
+
+      bool operator==(const Iterator& rhs) const noexcept
+      {
+        return rhs == *this;
+      }
+
+      bool operator!=(const Iterator& rhs) const noexcept
+      {
+        return rhs != *this;
+      }
+
+    };
+
+    Iterator begin() noexcept
+    {
+      return Iterator(*this);
+    }
+
+    Sentinel end() noexcept
+    {
+      return Sentinel();
+    }
+
+  // deleted:
+
+    LineSplitter() = delete;
+    LineSplitter(const LineSplitter&) = delete;
+    LineSplitter& operator=(LineSplitter&&) = delete;
+    LineSplitter& operator=(const LineSplitter&) = delete;
+
+  };
+
+}
+
+#endif
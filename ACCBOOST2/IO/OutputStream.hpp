@@ -5,6 +5,7 @@
 #include <string_view>
 #include "BINARY_TOOLS/Writer.hpp"
 #include "serialize.hpp"
+#include "trace.hpp"
 
 
 namespace ACCBOOST2::IO
@@ -19,53 +20,97 @@ namespace ACCBOOST2::IO
 
   private:
     
-    static constexpr std::size_t buffer_size = 4096;
+    static constexpr std::size_t default_buffer_size = 4096;
 
+    std::size_t buffer_size_;
     std::unique_ptr<char_type[]> buffer_;
     std::unique_ptr<BINARY_TOOLS::Writer<char_type>> writer_;
     std::size_t pos_;
 
   public:
 
-    explicit OutputStream(std::unique_ptr<BINARY_TOOLS::Writer<char_type>>&& writer):
-      buffer_(std::make_unique<char_type[]>(buffer_size)), writer_(std::move(writer)), pos_(0)
+    /**
+     * buffer_size はバッファの要素数で，0 ならば writer の preferred_buffer_size()（書き込むファイルの種類に応じて決まる）とする．
+     * writer が推奨値を持たない場合（端末など）は default_buffer_size とする．
+     */
+    explicit OutputStream(std::unique_ptr<BINARY_TOOLS::Writer<char_type>>&& writer, std::size_t buffer_size = 0):
+      buffer_size_(buffer_size != 0 ? buffer_size : writer != nullptr && writer->preferred_buffer_size() != 0 ? writer->preferred_buffer_size() : default_buffer_size),
+      buffer_(std::make_unique_for_overwrite<char_type[]>(buffer_size_)), writer_(std::move(writer)), pos_(0)
     {}
 
     OutputStream(OutputStream&& other) noexcept:
-      buffer_(std::move(other.buffer_)), writer_(std::move(other.writer_)), pos_(std::move(other.pos_))
+      buffer_size_(other.buffer_size_), buffer_(std::move(other.buffer_)), writer_(std::move(other.writer_)), pos_(std::move(other.pos_))
     {
       assert(other.buffer_ == nullptr);
       assert(other.writer_ == nullptr);
+      other.buffer_size_ = 0;
       other.pos_ = 0;
     }
 
-    ~OutputStream()
+    /**
+     * バッファの内容を書き出す．ここで発生した書き込みの例外は無視される．
+     * 書き込みの失敗（圧縮ファイルの終端を含む）を知る必要がある場合は，先に close() を呼ぶ．
+     */
+    ~OutputStream() noexcept
     {
-      if(pos_ != 0){
+      if(writer_ != nullptr){
         assert(buffer_ != nullptr);
-        assert(writer_ != nullptr);
-        flush();
+        try{
+          flush();
+        }catch(...){
+          // note: デストラクタから例外は投げられないので無視する．
+        }
       }
     }
 
-    void flush()
+    std::size_t buffer_size() const noexcept
+    {
+      return buffer_size_;
+    }
+
+  private:
+
+    /// バッファの内容を writer に渡す．
+    void _write()
     {
       assert(buffer_ != nullptr);
       assert(writer_ != nullptr);
       if(pos_ != 0){
+        TraceScope trace(TraceStage::flush);
+        trace.add_bytes(pos_);
         (*writer_)(buffer_.get(), pos_);
         pos_ = 0;
       }
     }
 
+  public:
+
+    /// バッファの内容を writer に渡し，writer にも書き出させる．close() の後は何もしない．
+    void flush()
+    {
+      if(writer_ == nullptr) return;
+      _write();
+      writer_->flush();
+    }
+
+    /// バッファの内容を書き出して writer を閉じる（圧縮ストリームの終端もここで書く）．エラーは例外として投げる．close() の後は書き込めない．
+    void close()
+    {
+      if(writer_ != nullptr){
+        _write();
+        auto writer = std::move(writer_);
+        writer->close();
+      }
+    }
+
     void operator()(const char_type& c)
     {
       assert(buffer_ != nullptr);
       assert(writer_ != nullptr);
-      assert(pos_ < buffer_size);
+      assert(pos_ < buffer_size_);
       buffer_[pos_++] = c;
-      if(pos_ == buffer_size){
-        flush();
+      if(pos_ == buffer_size_){
+        _write();
       }
     }
 
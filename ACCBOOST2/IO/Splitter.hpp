@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <string_view>
 #include <stdexcept>
+#include "trace.hpp"
 
 
 namespace ACCBOOST2::IO
@@ -55,6 +56,7 @@ private:
     void next() noexcept
     {
       assert(!eof());
+      TraceScope trace(TraceStage::split);
       _buffer.clear();
       while(_first != _last){
         char_type c = *_first;
@@ -62,6 +64,7 @@ private:
         if(c == _delimiter) break;
         _buffer.push_back(c);
       }
+      trace.add_bytes(_buffer.size());
     }
 
     class Sentinel;
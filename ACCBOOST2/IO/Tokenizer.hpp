@@ -0,0 +1,358 @@
+#ifndef ACCBOOST2_IO_TOKENIZER_HPP_
+#define ACCBOOST2_IO_TOKENIZER_HPP_
+
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "trace.hpp"
+
+
+namespace ACCBOOST2::IO
+{
+
+  /// 区切り文字の集合．1 バイトの文字 256 種類を 256 ビットの表で持つ．
+  class DelimiterSet
+  {
+  private:
+
+    std::uint64_t _bits[4];
+
+  public:
+
+    constexpr DelimiterSet() noexcept:
+      _bits{0, 0, 0, 0}
+    {}
+
+    constexpr explicit DelimiterSet(std::string_view characters) noexcept:
+      DelimiterSet()
+    {
+      for(char c: characters){
+        insert(c);
+      }
+    }
+
+    constexpr void insert(char c) noexcept
+    {
+      const auto u = static_cast<unsigned char>(c);
+      _bits[u >> 6] |= std::uint64_t{1} << (u & 63);
+    }
+
+    template<class CharT>
+    constexpr bool contains(const CharT& c) const noexcept
+    {
+      using UnsignedType = std::make_unsigned_t<CharT>;
+      const auto u = static_cast<UnsignedType>(c);
+      if constexpr (sizeof(CharT) > 1){
+        if(u >= 256) return false;
+      }
+      return (_bits[u >> 6] >> (u & 63)) & 1;
+    }
+
+  };
+
+
+  /// Tokenizer の書式．
+  struct TokenizerFormat
+  {
+    /// フィールドの区切り文字（改行 '\n' はレコードの区切りで，ここには含めない）
+    DelimiterSet delimiters;
+    /// true ならば連続する区切り文字を 1 つとみなし，行頭と行末の区切り文字を無視する
+    bool collapse_delimiters;
+    /// true ならば '"' で囲まれたフィールドの中の区切り文字と改行を文字として扱い，"" を " とする
+    bool quoted_fields;
+  };
+
+  /// 空白（' ', '\t', '\r', '\v', '\f'）区切り．MPS など．
+  inline constexpr TokenizerFormat WHITESPACE{DelimiterSet(" \t\r\v\f"), true, false};
+
+  /// RFC 4180 の CSV（行末の "\r\n" も扱う）．
+  inline constexpr TokenizerFormat CSV{DelimiterSet(","), false, true};
+
+
+  /// Tokenizer が返すフィールド．
+  template<class CharT>
+  struct Field
+  {
+    /// フィールドが始まる行の番号（1 から数える）
+    std::size_t line;
+    /// 行の中でのフィールドの番号（0 から数える）
+    std::size_t index;
+    /// フィールドの内容（次のフィールドに進むまで有効）
+    std::basic_string_view<CharT> value;
+  };
+
+
+  /**
+   * 入力を format に従ってフィールドに分け，Field を 1 つずつ返す．
+   * フィールドの内容は使い回す内部のバッファに置くので，フィールドごとのメモリ確保はしない．
+   * 空行は読み飛ばす．
+   */
+  template<class InputStreamType, class CharT>
+  class Tokenizer
+  {
+  public:
+
+    using char_type = CharT;
+
+  private:
+
+    static constexpr char_type _newline = char_type('\n');
+    static constexpr char_type _quote = char_type('"');
+
+    InputStreamType _input_stream;
+    TokenizerFormat _format;
+    // 区切り文字と改行（フィールドの終わり）
+    DelimiterSet _stops;
+    std::remove_cv_t<std::remove_reference_t<decltype(std::declval<InputStreamType&>().begin())>> _first;
+    std::remove_cv_t<std::remove_reference_t<decltype(std::declval<InputStreamType&>().end())>> _last;
+    std::basic_string<char_type> _buffer;
+    Field<char_type> _field;
+    std::size_t _line;
+    std::size_t _index;
+    // 直前に区切り文字を読んだので，行末や EOF でも（空の）フィールドが続く
+    bool _field_pending;
+    bool _eof;
+
+  public:
+
+    Tokenizer(InputStreamType&& input_stream, const TokenizerFormat& format):
+      _input_stream(std::forward<InputStreamType>(input_stream)), _format(format), _stops(format.delimiters),
+      _first(_input_stream.begin()), _last(_input_stream.end()), _buffer(), _field{0, 0, {}},
+      _line(1), _index(0), _field_pending(false), _eof(false)
+    {
+      _stops.insert('\n');
+      next();
+    }
+
+    Tokenizer(Tokenizer&&) = default;
+
+  private:
+
+    bool _is_delimiter(const char_type& c) const noexcept
+    {
+      return _format.delimiters.contains(c);
+    }
+
+    /// 空行と（collapse_delimiters ならば）区切り文字を読み飛ばして次のフィールドの先頭まで進める．EOF ならば false を返す．
+    bool _skip()
+    {
+      if(_field_pending) return true;
+      while(_first != _last){
+        const char_type c = *_first;
+        if(c == _newline){
+          ++_first;
+          ++_line;
+          _index = 0;
+        }else if(_format.collapse_delimiters && _is_delimiter(c)){
+          ++_first;
+        }else{
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// 区切り文字または改行の直前までを _buffer に追加する．連続した領域を読める場合はまとめて走査する．
+    void _read_unquoted()
+    {
+      if constexpr (requires(InputStreamType& x){x.buffered(); x.skip(std::size_t());}){
+        while(!_input_stream.eof()){
+          const auto view = _input_stream.buffered();
+          std::size_t k = 0;
+          while(k < view.size() && !_stops.contains(view[k])) ++k;
+          _buffer.append(view.data(), k);
+          _input_stream.skip(k);
+          if(k != view.size()) break;
+        }
+      }else if constexpr (std::contiguous_iterator<decltype(_first)>){
+        auto p = _first;
+        while(p != _last && !_stops.contains(*p)) ++p;
+        _buffer.append(std::to_address(_first), static_cast<std::size_t>(p - _first));
+        _first = p;
+      }else{
+        while(_first != _last){
+          const char_type c = *_first;
+          if(_stops.contains(c)) break;
+          _buffer.push_back(c);
+          ++_first;
+        }
+      }
+    }
+
+    void _read_quoted()
+    {
+      assert(*_first == _quote);
+      ++_first;
+      while(1){
+        if(_first == _last) throw std::runtime_error("Unterminated quoted field at line " + std::to_string(_field.line) + ".");
+        const char_type c = *_first;
+        ++_first;
+        if(c == _quote){
+          if(_first == _last || *_first != _quote) return;
+          ++_first;
+        }else if(c == _newline){
+          ++_line;
+        }
+        _buffer.push_back(c);
+      }
+    }
+
+  public:
+
+    bool eof() const noexcept
+    {
+      return _eof;
+    }
+
+    const Field<char_type>& get() const noexcept
+    {
+      assert(!eof());
+      return _field;
+    }
+
+    void next()
+    {
+      while(1){
+        if(!_skip()){
+          _eof = true;
+          return;
+        }
+        TraceScope trace(TraceStage::split);
+        const bool pending = _field_pending;
+        _field_pending = false;
+        _buffer.clear();
+        _field.line = _line;
+        _field.index = _index;
+        bool quoted = false;
+        // 引用符の中の文字数（これより後の '\r' のみを行末の "\r\n" の一部として取り除く）
+        std::size_t quoted_size = 0;
+        if(_format.quoted_fields && _first != _last && *_first == _quote){
+          _read_quoted();
+          quoted = true;
+          quoted_size = _buffer.size();
+        }
+        // note: 閉じた '"' の後に続く文字もフィールドに含める．
+        _read_unquoted();
+        trace.add_bytes(_buffer.size());
+        if(_first != _last && *_first != _newline){
+          // 区切り文字
+          ++_first;
+          ++_index;
+          _field_pending = !_format.collapse_delimiters;
+          break;
+        }
+        // 行末または EOF（"\r\n" の '\r' はフィールドに含めない）
+        if(_buffer.size() > quoted_size && _buffer.back() == char_type('\r')){
+          _buffer.pop_back();
+        }
+        if(_first != _last){
+          ++_first;
+        }
+        ++_line;
+        _index = 0;
+        // 空行（"\r\n" のみの行を含む）は読み飛ばす
+        if(pending || quoted || !_buffer.empty()) break;
+      }
+      _field.value = _buffer;
+    }
+
+    class Sentinel;
+
+    class Iterator
+    {
+    public:
+
+      using iterator_category = std::input_iterator_tag;
+      using difference_type = std::ptrdiff_t;
+      using value_type = Field<char_type>;
+      using reference = const Field<char_type>&;
+      using pointer = const Field<char_type>*;
+
+    private:
+
+      Tokenizer* _tokenizer = nullptr;
+
+    public:
+
+      Iterator() = default;
+      Iterator(Iterator&&) = default;
+      Iterator(const Iterator&) = default;
+      Iterator& operator=(Iterator&&) = default;
+      Iterator& operator=(const Iterator&) = default;
+
+      explicit Iterator(Tokenizer& tokenizer) noexcept:
+        _tokenizer(std::addressof(tokenizer))
+      {}
+
+      bool operator==(const Sentinel&) const noexcept
+      {
+        return _tokenizer->eof();
+      }
+
+      bool operator!=(const Sentinel&) const noexcept
+      {
+        return !_tokenizer->eof();
+      }
+
+      const Field<char_type>& operator*() const noexcept
+      {
+        return _tokenizer->get();
+      }
+
+      const Field<char_type>* operator->() const noexcept
+      {
+        return std::addressof(_tokenizer->get());
+      }
+
+      Iterator& operator++()
+      {
+        _tokenizer->next();
+        return *this;
+      }
+
+    };
+
+    class Sentinel
+    {
+    public:
+
+      bool operator==(const Iterator& rhs) const noexcept
+      {
+        return rhs == *this;
+      }
+
+      bool operator!=(const Iterator& rhs) const noexcept
+      {
+        return rhs != *this;
+      }
+
+    };
+
+    Iterator begin() noexcept
+    {
+      return Iterator(*this);
+    }
+
+    Sentinel end() noexcept
+    {
+      return Sentinel();
+    }
+
+  // deleted:
+
+    Tokenizer() = delete;
+    Tokenizer(const Tokenizer&) = delete;
+    Tokenizer& operator=(Tokenizer&&) = delete;
+    Tokenizer& operator=(const Tokenizer&) = delete;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,552 @@
+#ifndef ACCBOOST2_IO_COLUMNAR_HPP_
+#define ACCBOOST2_IO_COLUMNAR_HPP_
+
+
+/**
+ * Array, ZippedArray, Sparse2DArray を列ごとのバイナリ形式で保存・読み込みする．
+ *
+ * ファイルの構成:
+ *   - Header（マジックナンバー，バイト順，種類，大きさ，Header と ColumnHeader のチェックサム）
+ *   - 列の数だけの ColumnHeader（要素の型，要素の大きさ，位置，要素数，チェックサム）
+ *   - 各列の要素をそのまま並べたもの（先頭を alignment バイト境界に揃える）
+ * 数値は保存した計算機のバイト順で書き，異なるバイト順の計算機で読むときは算術型に限り変換する．
+ * 要素の型は自明にコピーできる型に限る．
+ */
+
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "BINARY_TOOLS/BinaryFileWriter.hpp"
+#include "BINARY_TOOLS/MappedFile.hpp"
+#include "../container/Array.hpp"
+#include "../container/ZippedArray.hpp"
+#include "../container/Sparse2DArray.hpp"
+
+
+namespace ACCBOOST2::IO
+{
+
+  namespace _impl_columnar
+  {
+
+    static constexpr char magic[8] = {'A', 'C', 'C', 'B', 'C', 'O', 'L', '\0'};
+
+    // note: 版 1 は Header のチェックサムを持たない．
+    static constexpr std::uint32_t version = 2;
+
+    // 書いた計算機のバイト順で書き，読むときに 0x04030201 と読めればバイト順が異なる
+    static constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+    // 各列の先頭の境界（mmap した領域をそのまま std::span として見られるようにする）
+    static constexpr std::size_t alignment = 64;
+
+    // チェックサムを持つ
+    static constexpr std::uint32_t has_checksum = 1;
+
+    enum class Kind: std::uint32_t
+    {
+      ARRAY = 1,
+      ZIPPED_ARRAY = 2,
+      SPARSE_2D_ARRAY = 3
+    };
+
+    struct Header
+    {
+      char magic[8];
+      std::uint32_t byte_order;
+      std::uint32_t version;
+      std::uint32_t kind;
+      std::uint32_t number_of_columns;
+      std::uint64_t size;
+      std::uint64_t row_size;
+      std::uint64_t column_size;
+      std::uint32_t flags;
+      // Header と ColumnHeader の並びのチェックサム（header_checksum を参照）
+      std::uint32_t header_checksum;
+    };
+
+    static_assert(sizeof(Header) == 56);
+
+    struct ColumnHeader
+    {
+      std::uint32_t type;
+      std::uint32_t element_size;
+      std::uint64_t offset;
+      std::uint64_t size;
+      std::uint64_t checksum;
+    };
+
+    static_assert(sizeof(ColumnHeader) == 32);
+
+    /// 要素の型を表す番号．算術型は種類と大きさで，それ以外は大きさのみで区別する．
+    template<class T>
+    constexpr std::uint32_t type_code() noexcept
+    {
+      if constexpr (std::is_enum_v<T>){
+        return type_code<std::underlying_type_t<T>>();
+      }else if constexpr (std::is_floating_point_v<T>){
+        return 0x300 | sizeof(T);
+      }else if constexpr (std::is_integral_v<T>){
+        return (std::is_signed_v<T> ? 0x200 : 0x100) | sizeof(T);
+      }else{
+        return 0x400;
+      }
+    }
+
+    template<class T>
+    static void byteswap(T* p, std::size_t n) noexcept
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      for(std::size_t i = 0; i < n; ++i){
+        auto* bytes = reinterpret_cast<std::byte*>(p + i);
+        std::reverse(bytes, bytes + sizeof(T));
+      }
+    }
+
+    static inline void byteswap_header(Header& header) noexcept
+    {
+      byteswap(&header.byte_order, 1);
+      byteswap(&header.version, 1);
+      byteswap(&header.kind, 1);
+      byteswap(&header.number_of_columns, 1);
+      byteswap(&header.size, 1);
+      byteswap(&header.row_size, 1);
+      byteswap(&header.column_size, 1);
+      byteswap(&header.flags, 1);
+      byteswap(&header.header_checksum, 1);
+    }
+
+    static inline void byteswap_column_header(ColumnHeader& column) noexcept
+    {
+      byteswap(&column.type, 1);
+      byteswap(&column.element_size, 1);
+      byteswap(&column.offset, 1);
+      byteswap(&column.size, 1);
+      byteswap(&column.checksum, 1);
+    }
+
+    /// バイト列のチェックサム．8 バイトずつリトルエンディアンで読み，4 系列に分けて計算するのでメモリの帯域に近い速さで計算できる．
+    static inline std::uint64_t checksum(const std::byte* data, std::size_t size) noexcept
+    {
+      constexpr std::uint64_t k = 0x9E3779B97F4A7C15ULL;
+      auto load = [](const std::byte* p) noexcept
+      {
+        std::uint64_t w;
+        std::memcpy(&w, p, sizeof(w));
+        if constexpr (std::endian::native == std::endian::big){
+          byteswap(&w, 1);
+        }
+        return w;
+      };
+      std::uint64_t h[4] = {k, k + 1, k + 2, k + 3};
+      std::size_t i = 0;
+      for(; i + 32 <= size; i += 32){
+        for(std::size_t j = 0; j < 4; ++j){
+          h[j] = std::rotl(h[j] ^ load(data + i + 8 * j), 29) * k;
+        }
+      }
+      std::uint64_t result = size;
+      for(std::size_t j = 0; j < 4; ++j){
+        result = std::rotl(result ^ h[j], 31) * k;
+      }
+      for(; i < size; ++i){
+        result = (result ^ static_cast<std::uint64_t>(data[i])) * 0x100000001B3ULL;
+      }
+      return result ^ (result >> 32);
+    }
+
+    /**
+     * ファイルの先頭 size バイト（Header と ColumnHeader の並び）の FNV-1a によるチェックサム．header_checksum の位置は 0 とみなす．
+     * 大きさや列の位置を壊れたまま信用してメモリを確保しないように，列のチェックサムの有無によらず検査する．
+     */
+    static inline std::uint32_t header_checksum(const std::byte* data, std::size_t size)
+    {
+      constexpr std::size_t first = offsetof(Header, header_checksum), last = first + sizeof(Header::header_checksum);
+      std::uint64_t result = 0xCBF29CE484222325ULL;
+      for(std::size_t i = 0; i < size; ++i){
+        const std::byte x = (first <= i && i < last) ? std::byte{0} : data[i];
+        result = (result ^ static_cast<std::uint64_t>(x)) * 0x100000001B3ULL;
+      }
+      return static_cast<std::uint32_t>(result ^ (result >> 32));
+    }
+
+    /// 保存する列．
+    struct Column
+    {
+      std::uint32_t type;
+      std::uint32_t element_size;
+      const std::byte* data;
+      std::uint64_t size;
+    };
+
+    template<class T>
+    Column make_column(const T* data, std::size_t size) noexcept
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      static_assert(alignof(T) <= alignment);
+      return {type_code<T>(), sizeof(T), reinterpret_cast<const std::byte*>(data), size};
+    }
+
+    static inline void write_all(BINARY_TOOLS::BinaryWriter& writer, const std::byte* data, std::size_t size)
+    {
+      // note: write() は 1 回で 2 GiB 程度までしか書けないので分けて渡す．
+      constexpr std::size_t max_bytes = std::size_t{1} << 30;
+      while(size != 0){
+        const std::size_t n = std::min(size, max_bytes);
+        writer(data, n);
+        data += n;
+        size -= n;
+      }
+    }
+
+    static inline void write(const std::string& path, Kind kind, std::uint64_t size, std::uint64_t row_size, std::uint64_t column_size, std::initializer_list<Column> columns, bool with_checksum)
+    {
+      Header header{};
+      std::memcpy(header.magic, magic, sizeof(magic));
+      header.byte_order = byte_order_mark;
+      header.version = version;
+      header.kind = static_cast<std::uint32_t>(kind);
+      header.number_of_columns = static_cast<std::uint32_t>(columns.size());
+      header.size = size;
+      header.row_size = row_size;
+      header.column_size = column_size;
+      header.flags = with_checksum ? has_checksum : 0;
+      auto align = [](std::uint64_t offset) noexcept {return (offset + alignment - 1) / alignment * alignment;};
+      Array<ColumnHeader> column_headers;
+      column_headers.reserve(columns.size());
+      std::uint64_t offset = align(sizeof(Header) + sizeof(ColumnHeader) * columns.size());
+      for(const auto& column: columns){
+        const std::uint64_t bytes = column.size * column.element_size;
+        column_headers.push_back(ColumnHeader{column.type, column.element_size, offset, column.size, with_checksum ? checksum(column.data, bytes) : 0});
+        offset = align(offset + bytes);
+      }
+      Array<std::byte> headers(sizeof(Header) + sizeof(ColumnHeader) * column_headers.size());
+      std::memcpy(headers.data(), &header, sizeof(Header));
+      std::memcpy(headers.data() + sizeof(Header), column_headers.data(), sizeof(ColumnHeader) * column_headers.size());
+      header.header_checksum = header_checksum(headers.data(), headers.size());
+      std::memcpy(headers.data(), &header, sizeof(Header));
+      const std::byte padding[alignment] = {};
+      auto writer = BINARY_TOOLS::make_binary_file_writer(path);
+      write_all(*writer, headers.data(), headers.size());
+      std::uint64_t position = sizeof(Header) + sizeof(ColumnHeader) * column_headers.size();
+      std::size_t k = 0;
+      for(const auto& column: columns){
+        write_all(*writer, padding, column_headers[k].offset - position);
+        const std::uint64_t bytes = column.size * column.element_size;
+        write_all(*writer, column.data, bytes);
+        position = column_headers[k].offset + bytes;
+        ++k;
+      }
+      // note: close() で初めて報告される書き込みのエラー（NFS など）も例外にする．
+      writer->close();
+    }
+
+  }
+
+
+  /**
+   * save で保存したファイルをメモリにマップして読む．
+   * column<T>(k) は k 番目の列をマップした領域のまま（コピーせずに）返すので，読み込みはページの読み込みだけで済む．
+   * 列の順序は Array では要素，ZippedArray では各列，Sparse2DArray では行の開始位置（row_size + 1 個の std::uint64_t），列番号，値．
+   */
+  class ColumnarFile
+  {
+  private:
+
+    std::string _path;
+    BINARY_TOOLS::MappedFile _file;
+    _impl_columnar::Header _header;
+    Array<_impl_columnar::ColumnHeader> _columns;
+    bool _byte_swapped;
+
+    [[noreturn]] void _invalid(const std::string& reason) const
+    {
+      throw std::runtime_error("\"" + _path + "\" is not a valid columnar file (" + reason + ").");
+    }
+
+    void _check_column(std::size_t k, std::uint32_t type, std::uint32_t element_size) const
+    {
+      if(k >= _columns.size()) _invalid("column " + std::to_string(k) + " does not exist");
+      if(_columns[k].type != type || _columns[k].element_size != element_size) _invalid("type mismatch in column " + std::to_string(k));
+    }
+
+    /// ファイルのバイト列から計算した Header のチェックサム．バイト順によらない値なので，_header.header_checksum とそのまま比べる．
+    std::uint32_t _header_checksum() const
+    {
+      return _impl_columnar::header_checksum(_file.data(), sizeof(_impl_columnar::Header) + sizeof(_impl_columnar::ColumnHeader) * _header.number_of_columns);
+    }
+
+  public:
+
+    explicit ColumnarFile(const std::string& path):
+      _path(path), _file(path), _header(), _columns(), _byte_swapped(false)
+    {
+      using namespace _impl_columnar;
+      if(_file.size() < sizeof(Header)) _invalid("too short");
+      std::memcpy(&_header, _file.data(), sizeof(Header));
+      if(std::memcmp(_header.magic, magic, sizeof(magic)) != 0) _invalid("bad magic number");
+      if(_header.byte_order != byte_order_mark){
+        byteswap_header(_header);
+        if(_header.byte_order != byte_order_mark) _invalid("bad byte order mark");
+        _byte_swapped = true;
+      }
+      if(_header.version != version) _invalid("unsupported version " + std::to_string(_header.version));
+      if(_header.number_of_columns > (_file.size() - sizeof(Header)) / sizeof(ColumnHeader)) _invalid("too short");
+      if(_header_checksum() != _header.header_checksum) _invalid("header checksum mismatch");
+      _columns.resize(_header.number_of_columns);
+      std::memcpy(_columns.data(), _file.data() + sizeof(Header), sizeof(ColumnHeader) * _columns.size());
+      for(auto& column: _columns){
+        if(_byte_swapped){
+          byteswap_column_header(column);
+        }
+        if(column.element_size == 0 || column.offset % alignment != 0 || column.offset > _file.size() || column.size > (_file.size() - column.offset) / column.element_size){
+          _invalid("column out of range");
+        }
+      }
+    }
+
+    ColumnarFile(ColumnarFile&&) = default;
+
+    const std::string& path() const noexcept
+    {
+      return _path;
+    }
+
+    /// Array, ZippedArray では要素数，Sparse2DArray では非ゼロ要素の数．
+    std::size_t size() const noexcept
+    {
+      return static_cast<std::size_t>(_header.size);
+    }
+
+    std::size_t row_size() const noexcept
+    {
+      return static_cast<std::size_t>(_header.row_size);
+    }
+
+    std::size_t column_size() const noexcept
+    {
+      return static_cast<std::size_t>(_header.column_size);
+    }
+
+    std::size_t number_of_columns() const noexcept
+    {
+      return _columns.size();
+    }
+
+    /// 保存した計算機とバイト順が異なるか．異なる場合は column で直接見ることはできない．
+    bool byte_swapped() const noexcept
+    {
+      return _byte_swapped;
+    }
+
+    bool has_checksum() const noexcept
+    {
+      return (_header.flags & _impl_columnar::has_checksum) != 0;
+    }
+
+    /// チェックサムを持つならば全ての列を読んで検査し，一致しなければ例外を投げる．
+    void verify() const
+    {
+      if(!has_checksum()) return;
+      for(std::size_t k = 0; k < _columns.size(); ++k){
+        const auto& column = _columns[k];
+        if(_impl_columnar::checksum(_file.data() + column.offset, column.size * column.element_size) != column.checksum){
+          _invalid("checksum mismatch in column " + std::to_string(k));
+        }
+      }
+    }
+
+    /**
+     * 種類と列の数，各列の要素数を検査する．
+     * 要素数は Array, ZippedArray では size()，Sparse2DArray では row_size() + 1（行の開始位置），size()，size() でなければならない．
+     */
+    void expect(_impl_columnar::Kind kind, std::size_t number_of_columns) const
+    {
+      using _impl_columnar::Kind;
+      if(_header.kind != static_cast<std::uint32_t>(kind) || _columns.size() != number_of_columns) _invalid("unexpected container type");
+      for(std::size_t k = 0; k < _columns.size(); ++k){
+        const bool offsets = kind == Kind::SPARSE_2D_ARRAY && k == 0;
+        if(offsets ? _header.row_size >= _columns[k].size || _columns[k].size - 1 != _header.row_size : _columns[k].size != _header.size){
+          _invalid("unexpected size of column " + std::to_string(k));
+        }
+      }
+    }
+
+    /// k 番目の列をコピーせずに返す（ColumnarFile が存在する間のみ有効）．バイト順が異なる場合は例外を投げる．
+    template<class T>
+    std::span<const T> column(std::size_t k) const
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      static_assert(alignof(T) <= _impl_columnar::alignment);
+      _check_column(k, _impl_columnar::type_code<T>(), sizeof(T));
+      if(_byte_swapped) _invalid("byte order differs; use load instead of column");
+      return {reinterpret_cast<const T*>(_file.data() + _columns[k].offset), static_cast<std::size_t>(_columns[k].size)};
+    }
+
+    /// 要素数が n である k 番目の列を out にコピーする．バイト順が異なる場合は算術型に限り変換する．
+    template<class T>
+    void copy_column(std::size_t k, T* out, std::size_t n) const
+    {
+      static_assert(std::is_trivially_copyable_v<T>);
+      _check_column(k, _impl_columnar::type_code<T>(), sizeof(T));
+      if(_columns[k].size != n) _invalid("unexpected size of column " + std::to_string(k));
+      if(n == 0) return;
+      std::memcpy(out, _file.data() + _columns[k].offset, n * sizeof(T));
+      if(_byte_swapped){
+        if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>){
+          _impl_columnar::byteswap(out, n);
+        }else{
+          _invalid("byte order differs and column " + std::to_string(k) + " is not arithmetic");
+        }
+      }
+    }
+
+  // deleted:
+
+    ColumnarFile() = delete;
+    ColumnarFile(const ColumnarFile&) = delete;
+    ColumnarFile& operator=(ColumnarFile&&) = delete;
+    ColumnarFile& operator=(const ColumnarFile&) = delete;
+
+  };
+
+
+  /// x を path に保存する．checksum が true ならば列ごとのチェックサムも書き，load で検査する．
+  template<class ValueType>
+  requires(
+    std::is_trivially_copyable_v<ValueType>
+  )
+  void save(const std::string& path, const Array<ValueType>& x, bool checksum = false)
+  {
+    using namespace _impl_columnar;
+    write(path, Kind::ARRAY, x.size(), 0, 0, {make_column(x.data(), x.size())}, checksum);
+  }
+
+  /// x を列ごとに連続した領域として path に保存する．
+  template<class... ValueTypes>
+  requires(
+    (... && std::is_trivially_copyable_v<ValueTypes>)
+  )
+  void save(const std::string& path, const ZippedArray<ValueTypes...>& x, bool checksum = false)
+  {
+    using namespace _impl_columnar;
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+      write(path, Kind::ZIPPED_ARRAY, x.size(), 0, 0, {make_column(x.template data<I>(), x.size())...}, checksum);
+    }(std::index_sequence_for<ValueTypes...>());
+  }
+
+  /// x を圧縮行形式（行の開始位置，列番号，値）で path に保存する．行の中の要素の順序は保たれる．
+  template<class ValueType, class ListType, class IndexType>
+  requires(
+    std::is_trivially_copyable_v<ValueType>
+  )
+  void save(const std::string& path, const Sparse2DArray<ValueType, ListType, IndexType>& x, bool checksum = false)
+  {
+    using namespace _impl_columnar;
+    Array<std::uint64_t> row_offsets;
+    row_offsets.reserve(x.row_size() + 1);
+    row_offsets.push_back(0);
+    for(std::size_t i = 0; i < x.row_size(); ++i){
+      row_offsets.push_back(row_offsets[i] + x.row(i).size());
+    }
+    const std::size_t n = row_offsets[x.row_size()];
+    Array<IndexType> column_indices;
+    Array<ValueType> values;
+    column_indices.reserve(n);
+    values.reserve(n);
+    for(std::size_t i = 0; i < x.row_size(); ++i){
+      for(auto&& [i_, j, v]: x.row(i)){
+        column_indices.push_back_without_allocation(j);
+        values.push_back_without_allocation(v);
+      }
+    }
+    write(
+      path, Kind::SPARSE_2D_ARRAY, n, x.row_size(), x.column_size(),
+      {make_column(row_offsets.data(), row_offsets.size()), make_column(column_indices.data(), n), make_column(values.data(), n)},
+      checksum
+    );
+  }
+
+
+  /// path から x に読み込む（x の内容は置き換えられる）．チェックサムを持つファイルでは検査する．
+  template<class ValueType>
+  requires(
+    std::is_trivially_copyable_v<ValueType>
+  )
+  void load(const std::string& path, Array<ValueType>& x)
+  {
+    const ColumnarFile file(path);
+    file.expect(_impl_columnar::Kind::ARRAY, 1);
+    file.verify();
+    x.clear();
+    if(!file.byte_swapped()){
+      const auto column = file.column<ValueType>(0);
+      // note: 連続した領域からの expand は memcpy になる．
+      x.expand(column);
+    }else{
+      x.resize(file.size());
+      file.copy_column(0, x.data(), x.size());
+    }
+  }
+
+  template<class... ValueTypes>
+  requires(
+    (... && std::is_trivially_copyable_v<ValueTypes>)
+  )
+  void load(const std::string& path, ZippedArray<ValueTypes...>& x)
+  {
+    const ColumnarFile file(path);
+    file.expect(_impl_columnar::Kind::ZIPPED_ARRAY, sizeof...(ValueTypes));
+    file.verify();
+    x.clear();
+    x.resize(file.size());
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+      (file.copy_column(I, x.template data<I>(), x.size()), ...);
+    }(std::index_sequence_for<ValueTypes...>());
+  }
+
+  template<class ValueType, class ListType, class IndexType>
+  requires(
+    std::is_trivially_copyable_v<ValueType>
+  )
+  void load(const std::string& path, Sparse2DArray<ValueType, ListType, IndexType>& x)
+  {
+    const ColumnarFile file(path);
+    file.expect(_impl_columnar::Kind::SPARSE_2D_ARRAY, 3);
+    if(file.row_size() > std::numeric_limits<IndexType>::max() || file.column_size() > std::numeric_limits<IndexType>::max()){
+      throw std::runtime_error("\"" + path + "\" has a size that does not fit in the index type.");
+    }
+    file.verify();
+    Array<std::uint64_t> row_offsets(file.row_size() + 1);
+    Array<IndexType> column_indices(file.size());
+    Array<ValueType> values(file.size());
+    file.copy_column(0, row_offsets.data(), row_offsets.size());
+    file.copy_column(1, column_indices.data(), column_indices.size());
+    file.copy_column(2, values.data(), values.size());
+    x.release();
+    x.resize_row(file.row_size());
+    x.resize_column(file.column_size());
+    x.reserve(file.size());
+    for(std::size_t i = 0; i < file.row_size(); ++i){
+      if(row_offsets[i] > row_offsets[i + 1] || row_offsets[i + 1] > file.size()) throw std::runtime_error("\"" + path + "\" has broken row offsets.");
+      for(std::size_t k = row_offsets[i]; k < row_offsets[i + 1]; ++k){
+        if(column_indices[k] >= file.column_size()) throw std::runtime_error("\"" + path + "\" has a column index out of range.");
+        x.emplace(i, column_indices[k], values[k]);
+      }
+    }
+  }
+
+}
+
+
+#endif
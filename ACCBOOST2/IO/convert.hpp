@@ -2,14 +2,48 @@
 #define ACCBOOST2_IO_CONVERT_HPP_
 
 
+#include <cassert>
 #include <ranges>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
+#include "BINARY_TOOLS/transcode.hpp"
 
 
 namespace ACCBOOST2::IO
 {
 
+  namespace _impl_convert
+  {
+
+    template<class CharType>
+    struct Encoding;
+
+    template<>
+    struct Encoding<char8_t>
+    {
+      using type = BINARY_TOOLS::_impl_transcode::U8;
+    };
+
+    template<>
+    struct Encoding<char16_t>
+    {
+      using type = BINARY_TOOLS::_impl_transcode::U16<std::endian::native>;
+    };
+
+    template<>
+    struct Encoding<char32_t>
+    {
+      using type = BINARY_TOOLS::_impl_transcode::U32;
+    };
+
+    template<class CharType>
+    concept unicode_char = std::is_same_v<CharType, char8_t> || std::is_same_v<CharType, char16_t> || std::is_same_v<CharType, char32_t>;
+
+  }
+
+
+  /// ASCII の文字列を変換する．
   template<class ToCharType, class FromRangeType>
   requires(
     std::ranges::range<FromRangeType> &&
@@ -17,21 +51,49 @@ namespace ACCBOOST2::IO
   )
   std::basic_string<ToCharType> convert(FromRangeType&& from)
   {
+    static_assert(std::is_same_v<ToCharType, char> || _impl_convert::unicode_char<ToCharType>, "Not implemented.");
     std::basic_string<ToCharType> result;
     if constexpr (std::is_same_v<ToCharType, char>){
       result = from;
-    }else if constexpr (std::is_same_v<ToCharType, char8_t>){
+    }else{
       for(auto&& c: from){
-        assert(c <= 0x7f);
-        result.push_back(static_cast<char8_t>(c));
+        assert(static_cast<unsigned char>(c) <= 0x7f);
+        result.push_back(static_cast<ToCharType>(c));
       }
-    }else{
-      static_assert("Not implemented.");
     }
     return result;
   }
 
 
+  /**
+   * UTF-8（char8_t），UTF-16（char16_t），UTF-32（char32_t）の文字列を相互に変換する．
+   * 不正な文字列や途中で途切れた文字列ならば std::runtime_error を投げる．
+   */
+  template<class ToCharType, class FromRangeType>
+  requires(
+    std::ranges::contiguous_range<FromRangeType> &&
+    std::ranges::sized_range<FromRangeType> &&
+    _impl_convert::unicode_char<std::ranges::range_value_t<FromRangeType>> &&
+    _impl_convert::unicode_char<ToCharType>
+  )
+  std::basic_string<ToCharType> convert(FromRangeType&& from)
+  {
+    using FromCharType = std::ranges::range_value_t<FromRangeType>;
+    using From = typename _impl_convert::Encoding<FromCharType>::type;
+    using To = typename _impl_convert::Encoding<ToCharType>::type;
+    using FromUnitType = typename From::unit_type;
+    using ToUnitType = typename To::unit_type;
+    const auto* s = reinterpret_cast<const FromUnitType*>(std::ranges::data(from));
+    const std::size_t n = std::ranges::size(from) * sizeof(FromCharType) / sizeof(FromUnitType);
+    std::basic_string<ToCharType> result;
+    result.resize(BINARY_TOOLS::_impl_transcode::max_output_size<From, To>(n) * sizeof(ToUnitType) / sizeof(ToCharType));
+    auto [read, written] = BINARY_TOOLS::_impl_transcode::transcode<From, To>(s, n, reinterpret_cast<ToUnitType*>(result.data()));
+    if(read != n) BINARY_TOOLS::_impl_transcode::invalid_encoding();
+    result.resize(written * sizeof(ToUnitType) / sizeof(ToCharType));
+    return result;
+  }
+
+
 }
 
 #endif
@@ -0,0 +1,115 @@
+#ifndef ACCBOOST2_IO_PARALLEL_CHUNKS_HPP_
+#define ACCBOOST2_IO_PARALLEL_CHUNKS_HPP_
+
+
+#include <algorithm>
+#include <concepts>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "BINARY_TOOLS/MappedFile.hpp"
+#include "../container/Array.hpp"
+#include "../parallel/ThreadPool.hpp"
+
+
+namespace ACCBOOST2::IO
+{
+
+  /// parallel_for_each_chunk などで 1 つのチャンクに割り当てるバイト数の既定値．
+  static constexpr std::size_t default_chunk_size = 1 << 22;
+
+  /**
+   * data を約 chunk_size 要素ずつに分ける．
+   * 各チャンクの終わりは直後の delimiter の次まで延ばすので，区切り文字で区切られた行やレコードがチャンクをまたぐことはない．
+   * チャンクを順につなげると data 全体になる．
+   */
+  template<class CharT>
+  Array<std::basic_string_view<CharT>> split_into_chunks(std::basic_string_view<CharT> data, CharT delimiter, std::size_t chunk_size = default_chunk_size)
+  {
+    chunk_size = std::max<std::size_t>(chunk_size, 1);
+    Array<std::basic_string_view<CharT>> chunks;
+    chunks.reserve(data.size() / chunk_size + 1);
+    std::size_t first = 0;
+    while(first < data.size()){
+      std::size_t last = data.size();
+      if(data.size() - first > chunk_size){
+        const std::size_t position = data.find(delimiter, first + chunk_size - 1);
+        if(position != std::basic_string_view<CharT>::npos){
+          last = position + 1;
+        }
+      }
+      chunks.push_back(data.substr(first, last - first));
+      first = last;
+    }
+    return chunks;
+  }
+
+
+  /**
+   * ファイルをメモリにマップして区切り文字で揃えたチャンクに分け（split_into_chunks を参照），各チャンクに f を並列に適用する．
+   * f(chunk) は std::basic_string_view<CharT> を受け取り，複数のスレッドから順不同に呼ばれる．
+   * チャンクの中は IO::split(chunk, delimiter) や string_to で逐次のときと同じように解析できる．
+   * ファイルの内容は文字コードの検査をしない（CharT は char または char8_t）．
+   */
+  template<class CharT = char8_t, class F>
+  requires(
+    sizeof(CharT) == 1 &&
+    std::invocable<F&, std::basic_string_view<CharT>>
+  )
+  void parallel_for_each_chunk(const std::string& file_path, F&& f, CharT delimiter = CharT('\n'), std::size_t chunk_size = default_chunk_size, ThreadPool& thread_pool = ThreadPool::global())
+  {
+    // note: チャンクは複数のスレッドから順不同に読まれるので MADV_SEQUENTIAL は使わず，チャンクごとに will_need で先読みさせる．
+    const BINARY_TOOLS::MappedFile file(file_path, BINARY_TOOLS::MappedFile::AccessPattern::NORMAL);
+    const auto data = file.view<CharT>();
+    const auto chunks = split_into_chunks(data, delimiter, chunk_size);
+    thread_pool.run(chunks.size(), [&](std::size_t k)
+    {
+      file.will_need(static_cast<std::size_t>(chunks[k].data() - data.data()), chunks[k].size());
+      f(chunks[k]);
+    });
+  }
+
+
+  /**
+   * parallel_for_each_chunk と同様にチャンクごとに parse(chunk) を並列に計算し，その結果を consume に元の順序で渡す．
+   * consume は呼び出したスレッドで逐次に呼ばれる．
+   * メモリの使用量を抑えるため，スレッド数の window 倍のチャンクずつ解析しては結果を渡す．
+   * parse の結果の型はムーブ構築できればよい（既定構築や代入はしない）．
+   */
+  template<class CharT = char8_t, class ParseF, class ConsumeF>
+  requires(
+    sizeof(CharT) == 1 &&
+    std::invocable<ParseF&, std::basic_string_view<CharT>> &&
+    std::move_constructible<std::invoke_result_t<ParseF&, std::basic_string_view<CharT>>> &&
+    std::invocable<ConsumeF&, std::invoke_result_t<ParseF&, std::basic_string_view<CharT>>&&>
+  )
+  void parallel_transform_chunks(const std::string& file_path, ParseF&& parse, ConsumeF&& consume, CharT delimiter = CharT('\n'), std::size_t chunk_size = default_chunk_size, ThreadPool& thread_pool = ThreadPool::global(), std::size_t window = 4)
+  {
+    using ResultType = std::invoke_result_t<ParseF&, std::basic_string_view<CharT>>;
+    const BINARY_TOOLS::MappedFile file(file_path, BINARY_TOOLS::MappedFile::AccessPattern::NORMAL);
+    const auto data = file.view<CharT>();
+    const auto chunks = split_into_chunks(data, delimiter, chunk_size);
+    const std::size_t step = std::max<std::size_t>(thread_pool.concurrency() * window, 1);
+    Array<std::optional<ResultType>> results(std::min(step, chunks.size()));
+    for(std::size_t first = 0; first < chunks.size(); first += step){
+      const std::size_t n = std::min(step, chunks.size() - first);
+      thread_pool.run(n, [&](std::size_t k)
+      {
+        const auto& chunk = chunks[first + k];
+        file.will_need(static_cast<std::size_t>(chunk.data() - data.data()), chunk.size());
+        results[k].emplace(parse(chunk));
+      });
+      for(std::size_t k = 0; k < n; ++k){
+        assert(results[k].has_value());
+        consume(std::move(*results[k]));
+        results[k].reset();
+      }
+    }
+  }
+
+
+}
+
+
+#endif
@@ -6,6 +6,7 @@
 #include <charconv>
 #include <type_traits>
 #include <stdexcept>
+#include "trace.hpp"
 
 
 namespace ACCBOOST2::IO
@@ -33,6 +34,8 @@ namespace ACCBOOST2::IO
   )
   ValueT string_to(const std::basic_string_view<CharT, Traits>& string_view)
   {
+    TraceScope trace(TraceStage::string_to);
+    trace.add_bytes(string_view.size());
     if(string_view.size() > 64) throw std::runtime_error("string_to failure.");
     char buffer[64];
     std::size_t i = 0;
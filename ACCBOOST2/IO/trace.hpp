@@ -0,0 +1,201 @@
+#ifndef ACCBOOST2_IO_TRACE_HPP_
+#define ACCBOOST2_IO_TRACE_HPP_
+
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+
+
+namespace ACCBOOST2::IO
+{
+
+  /**
+   * 入出力の処理段階．
+   * 計測時間は内側の段階を含む（例えば decode の時間には read の時間が含まれる）．
+   */
+  enum class TraceStage: std::size_t
+  {
+    /// BinaryReader によるファイルからの読み込み（read システムコール）
+    read,
+    /// 圧縮されたファイルの伸長（BINARY_TOOLS::make_decompressing_reader を参照）
+    decompress,
+    /// Decoder による文字コードの検査・変換
+    decode,
+    /// InputStream のバッファの補充
+    refill,
+    /// Splitter による区切り文字での分割（1 トークンごと）
+    split,
+    /// string_to による文字列からの変換
+    string_to,
+    /// OutputStream のバッファの書き出し
+    flush,
+    /// Encoder による文字コードの検査・変換
+    encode,
+    /// 書き込むデータの圧縮（BINARY_TOOLS::make_compressing_file_writer を参照）
+    compress,
+    /// BinaryWriter によるファイルへの書き込み（write システムコール）
+    write,
+    /// 段階の数
+    size
+  };
+
+  /// 処理段階ごとの集計．
+  struct TraceRecord
+  {
+    /// 呼び出し回数
+    std::uint64_t calls = 0;
+    /// 処理した要素数（文字数またはバイト数）
+    std::uint64_t bytes = 0;
+    /// 経過時間の合計 [ns]
+    std::uint64_t nanoseconds = 0;
+  };
+
+  static constexpr std::size_t number_of_trace_stages = static_cast<std::size_t>(TraceStage::size);
+
+  static inline const char* trace_stage_name(TraceStage stage) noexcept
+  {
+    constexpr const char* names[] = {"read", "decompress", "decode", "refill", "split", "string_to", "flush", "encode", "compress", "write"};
+    static_assert(std::size(names) == number_of_trace_stages);
+    return names[static_cast<std::size_t>(stage)];
+  }
+
+  namespace _impl_trace
+  {
+
+    struct Counters
+    {
+      std::atomic<std::uint64_t> calls{0};
+      std::atomic<std::uint64_t> bytes{0};
+      std::atomic<std::uint64_t> nanoseconds{0};
+    };
+
+    inline std::array<Counters, number_of_trace_stages> counters;
+
+  }
+
+
+#if defined(ACCBOOST2_IO_TRACE)
+
+  /**
+   * 生存期間を stage の経過時間として集計する．
+   * 集計はスレッド間で共有され，ACCBOOST2_IO_TRACE が定義されていない場合は何もしない．
+   */
+  class TraceScope
+  {
+  private:
+
+    using clock = std::chrono::steady_clock;
+
+    TraceStage _stage;
+    std::uint64_t _bytes;
+    clock::time_point _start;
+
+  public:
+
+    explicit TraceScope(TraceStage stage) noexcept:
+      _stage(stage), _bytes(0), _start(clock::now())
+    {}
+
+    ~TraceScope() noexcept
+    {
+      const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _start).count();
+      auto& counters = _impl_trace::counters[static_cast<std::size_t>(_stage)];
+      counters.calls.fetch_add(1, std::memory_order_relaxed);
+      counters.bytes.fetch_add(_bytes, std::memory_order_relaxed);
+      counters.nanoseconds.fetch_add(static_cast<std::uint64_t>(elapsed), std::memory_order_relaxed);
+    }
+
+    /// 処理した要素数を加える．
+    void add_bytes(std::size_t n) noexcept
+    {
+      _bytes += n;
+    }
+
+  // deleted:
+
+    TraceScope(TraceScope&&) = delete;
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+  };
+
+#else
+
+  class TraceScope
+  {
+  public:
+
+    explicit TraceScope(TraceStage) noexcept
+    {}
+
+    void add_bytes(std::size_t) noexcept
+    {}
+
+  // deleted:
+
+    TraceScope(TraceScope&&) = delete;
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+  };
+
+#endif
+
+
+  /// 処理段階ごとの集計の現在値．
+  static inline std::array<TraceRecord, number_of_trace_stages> trace_summary() noexcept
+  {
+    std::array<TraceRecord, number_of_trace_stages> result;
+    for(std::size_t i = 0; i < number_of_trace_stages; ++i){
+      const auto& counters = _impl_trace::counters[i];
+      result[i].calls = counters.calls.load(std::memory_order_relaxed);
+      result[i].bytes = counters.bytes.load(std::memory_order_relaxed);
+      result[i].nanoseconds = counters.nanoseconds.load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  static inline TraceRecord trace_summary(TraceStage stage) noexcept
+  {
+    return trace_summary()[static_cast<std::size_t>(stage)];
+  }
+
+  static inline void reset_trace() noexcept
+  {
+    for(auto& counters: _impl_trace::counters){
+      counters.calls.store(0, std::memory_order_relaxed);
+      counters.bytes.store(0, std::memory_order_relaxed);
+      counters.nanoseconds.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /// 呼び出されたことのある処理段階について，呼び出し回数，要素数，時間とスループットを 1 行ずつ出力する．
+  static inline void report_trace(std::ostream& stream)
+  {
+    stream << "stage\tcalls\tbytes\tseconds\tMB/s\n";
+    const auto summary = trace_summary();
+    for(std::size_t i = 0; i < number_of_trace_stages; ++i){
+      const TraceRecord& record = summary[i];
+      if(record.calls == 0) continue;
+      const double seconds = static_cast<double>(record.nanoseconds) * 1e-9;
+      stream << trace_stage_name(static_cast<TraceStage>(i))
+        << "\t" << record.calls
+        << "\t" << record.bytes
+        << "\t" << seconds
+        << "\t" << (record.nanoseconds != 0 ? static_cast<double>(record.bytes) * 1e3 / static_cast<double>(record.nanoseconds) : 0.0)
+        << "\n";
+    }
+    stream.flush();
+  }
+
+}
+
+
+#endif
@@ -2,8 +2,10 @@
 #define ACCBOOST2_CONTAINER_ARRAY_HPP_
 
 
+#include <cstring>
 #include "../utility.hpp"
 #include "MEMORY/allocate.hpp"
+#include "MEMORY/statistics.hpp"
 
 
 namespace ACCBOOST2
@@ -26,6 +28,7 @@ namespace ACCBOOST2
     ValueType* _pointer;
     std::size_t _capacity;
     std::size_t _size;
+    [[no_unique_address]] MEMORY::Counter<Array> _number_of_allocations;
 
   public:
 
@@ -47,7 +50,7 @@ namespace ACCBOOST2
     }
 
     Array(Array&& other) noexcept:
-      _pointer(other._pointer), _capacity(other._capacity), _size(other._size)
+      _pointer(other._pointer), _capacity(other._capacity), _size(other._size), _number_of_allocations(other._number_of_allocations)
     {
       other._pointer = nullptr;
       other._capacity = 0;
@@ -88,6 +91,7 @@ namespace ACCBOOST2
       swap(_pointer, rhs._pointer);
       swap(_capacity, rhs._capacity);
       swap(_size, rhs._size);
+      swap(_number_of_allocations, rhs._number_of_allocations);
       return *this;
     }
 
@@ -120,6 +124,16 @@ namespace ACCBOOST2
       return _size;
     }
 
+    /// 確保しているメモリの統計
+    MEMORY::Statistics stats() const noexcept
+    {
+      MEMORY::Statistics result;
+      result.allocations = _number_of_allocations.value();
+      result.reserved_bytes = _capacity * sizeof(ValueType);
+      result.live_bytes = _size * sizeof(ValueType);
+      return result;
+    }
+
     ValueType& operator[](std::size_t i) noexcept
     {
       assert(i < _size);
@@ -132,6 +146,16 @@ namespace ACCBOOST2
       return _pointer[i];
     }
 
+    ValueType* data() noexcept
+    {
+      return _pointer;
+    }
+
+    const ValueType* data() const noexcept
+    {
+      return _pointer;
+    }
+
     ValueType* begin() noexcept
     {
       return _pointer;
@@ -158,6 +182,7 @@ namespace ACCBOOST2
     {
       assert(new_capacity > _capacity);
       ValueType* new_pointer = MEMORY::allocate<ValueType>(new_capacity);
+      ++_number_of_allocations;
       for(std::size_t i = 0; i < _size; ++i){
         MEMORY::construct(new_pointer + i, std::move(_pointer[i]));
         MEMORY::destroy(_pointer + i);
@@ -199,7 +224,25 @@ namespace ACCBOOST2
     void expand(const RangeType& x)
     {
       static_assert(std::ranges::range<RangeType>);
-      if constexpr (std::ranges::random_access_range<RangeType>){
+      if constexpr (
+        std::ranges::contiguous_range<const RangeType> &&
+        std::ranges::sized_range<const RangeType> &&
+        std::is_same_v<std::remove_cv_t<std::ranges::range_value_t<const RangeType>>, ValueType> &&
+        std::is_trivially_copyable_v<ValueType>
+      ){
+        // 連続した領域からのコピーは memcpy で行う
+        const std::size_t n = static_cast<std::size_t>(std::ranges::size(x));
+        if(n != 0){
+          reserve(size() + n);
+          std::memcpy(_pointer + _size, std::ranges::data(x), n * sizeof(ValueType));
+          _size += n;
+        }
+      }else if constexpr (std::ranges::sized_range<const RangeType>){
+        reserve(size() + static_cast<std::size_t>(std::ranges::size(x)));
+        for(auto&& y: x){
+          push_back_without_allocation(std::forward<decltype(y)>(y));
+        }
+      }else if constexpr (std::ranges::random_access_range<RangeType>){
         reserve(size() + (x.end() - x.begin()));
         for(auto&& y: x){
           push_back_without_allocation(std::forward<decltype(y)>(y));
@@ -33,11 +33,20 @@ struct HashFunction
   std::uint64_t operator()(const std::tuple<X, Y>& index) const noexcept
   {
     // 2 つの整数の組
-    std::uint64_t h = (
-      (static_cast<std::uint64_t>(ACCBOOST2::get<0>(index)) << 32)
-      + (static_cast<std::uint64_t>(ACCBOOST2::get<0>(index)) >> 32)
-      + static_cast<std::uint64_t>(ACCBOOST2::get<1>(index))
-    );
+    std::uint64_t h;
+    if constexpr (sizeof(std::remove_reference_t<X>) <= 4 && sizeof(std::remove_reference_t<Y>) <= 4){
+      // 共に 32 bit 以下ならば 64 bit に詰める
+      h = (
+        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(ACCBOOST2::get<0>(index))) << 32)
+        | static_cast<std::uint64_t>(static_cast<std::uint32_t>(ACCBOOST2::get<1>(index)))
+      );
+    }else{
+      h = (
+        (static_cast<std::uint64_t>(ACCBOOST2::get<0>(index)) << 32)
+        + (static_cast<std::uint64_t>(ACCBOOST2::get<0>(index)) >> 32)
+        + static_cast<std::uint64_t>(ACCBOOST2::get<1>(index))
+      );
+    }
     h ^= h >> 23;
     h *= 0x2127599bf4325c37ULL;
     h ^= h >> 47;
@@ -107,6 +116,11 @@ private:
       HashTableItem(), List::Item(), _key(std::forward<K>(key)), _value(std::forward<V>(value))
     {}
 
+    template<class K, class... Args>
+    Item(std::in_place_t, K&& key, Args&&... args):
+      HashTableItem(), List::Item(), _key(std::forward<K>(key)), _value(std::forward<Args>(args)...)
+    {}
+
     const KeyType& key() const noexcept
     {
       return _key;
@@ -137,6 +151,7 @@ private:
   MEMORY::MemoryPool<Item> _memory_pool;
   HashTable _hash_table;
   List _list;
+  [[no_unique_address]] MEMORY::Registration<Dictionary> _registration{"Dictionary", this};
 
 private:
 
@@ -154,7 +169,11 @@ public:
 
   Dictionary() = default;
 
-  Dictionary(Dictionary&&) = default;
+  Dictionary(Dictionary&& other) noexcept:
+    _memory_pool(std::move(other._memory_pool)),
+    _hash_table(std::move(other._hash_table)),
+    _list(std::move(other._list))
+  {}
 
   ~Dictionary() noexcept
   {
@@ -169,28 +188,111 @@ public:
     return _list.size();
   }
 
+  /// n 個の要素を格納するまで追加のメモリ確保やハッシュテーブルの再構築が起きないようにする．
+  void reserve(std::size_t n)
+  {
+    _memory_pool.reserve(n);
+    _hash_table.reserve(n);
+  }
+
+  std::size_t bucket_count() const noexcept
+  {
+    return _hash_table.bucket_count();
+  }
+
+  double load_factor() const noexcept
+  {
+    return _hash_table.load_factor();
+  }
+
+  SPARSE_ASSEMBLY::ProbeStatistics probe_statistics() const noexcept
+  {
+    return _hash_table.probe_statistics();
+  }
+
+  /// メモリプールとハッシュテーブルが確保しているメモリの統計
+  MEMORY::Statistics stats() const noexcept
+  {
+    MEMORY::Statistics result = _hash_table.stats();
+    const MEMORY::Statistics pool = _memory_pool.stats();
+    result.allocations += pool.allocations;
+    result.reserved_bytes += pool.reserved_bytes;
+    result.live_bytes += pool.live_bytes;
+    result.occupancy = pool.occupancy;
+    return result;
+  }
+
   template<class K>
   bool contain(const K& key) const noexcept
   {
     return _hash_table.get(key) != nullptr;
   }
 
+private:
+
+  /// search_for_add で得た位置に要素を追加する．
+  template<class K, class... Args>
+  Item* _add(const typename HashTable::AddPosition& add_position, K&& key, Args&&... args)
+  {
+    Item* item = _memory_pool.create(std::in_place, std::forward<K>(key), std::forward<Args>(args)...);
+    // NOTE これ以降例外は投げられない
+    _hash_table.add(add_position, item);
+    _list.push_back(item);
+    return item;
+  }
+
+public:
+
   template<class K, class V>
   void add(K&& key, V&& value)
   {
-    assert(_hash_table.get(key) == nullptr);
-    Item* item = _memory_pool.create(std::forward<K>(key), std::forward<V>(value));
-    try{
-      _hash_table.add(item);
-      try{
-        _list.push_back(item);
-      }catch(...){
-        _hash_table.erase(item);
-        throw;
-      }
-    }catch(...){
-      _memory_pool.destroy(item);
-      throw;
+    auto [found_item, add_position] = _hash_table.search_for_add(key);
+    assert(found_item == nullptr); static_cast<void>(found_item);
+    _add(add_position, std::forward<K>(key), std::forward<V>(value));
+  }
+
+  /**
+   * key が存在しなければ args から値を構築して追加し，存在すれば何もしない．
+   * 値への参照と，追加したか否かの組を返す．
+   */
+  template<class K, class... Args>
+  std::tuple<ValueType&, bool> try_emplace(K&& key, Args&&... args)
+  {
+    auto [found_item, add_position] = _hash_table.search_for_add(key);
+    if(found_item != nullptr){
+      return {static_cast<Item*>(found_item)->value(), false};
+    }else{
+      return {_add(add_position, std::forward<K>(key), std::forward<Args>(args)...)->value(), true};
+    }
+  }
+
+  /**
+   * key が存在しなければ値を既定構築して追加した上で，値に f を適用する．
+   * f の戻り値は無視され，値への参照を返す．
+   */
+  template<class K, class F>
+  requires(
+    std::is_default_constructible_v<ValueType> &&
+    std::invocable<F&&, ValueType&>
+  )
+  ValueType& emplace_or_update(K&& key, F&& f)
+  {
+    ValueType& value = ACCBOOST2::get<0>(try_emplace(std::forward<K>(key)));
+    std::invoke(std::forward<F>(f), value);
+    return value;
+  }
+
+  /// key が存在しなければ value を追加し，存在すれば値に value を加える．
+  template<class K, class V>
+  ValueType& accumulate(K&& key, V&& value)
+  {
+    auto [found_item, add_position] = _hash_table.search_for_add(key);
+    if(found_item != nullptr){
+      ValueType& found_value = static_cast<Item*>(found_item)->value();
+      found_value += std::forward<V>(value);
+      return found_value;
+    }else{
+      return _add(add_position, std::forward<K>(key), std::forward<V>(value))->value();
     }
   }
 
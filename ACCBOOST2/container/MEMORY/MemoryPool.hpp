@@ -25,9 +25,30 @@ namespace ACCBOOST2::MEMORY
       _allocator(n)
     {}
 
+    /// 確保済みの要素数
+    ACCBOOST2_INLINE const std::size_t& capacity() const noexcept
+    {
+      return _allocator.capacity();
+    }
+
+    /// 生成中の要素数
+    ACCBOOST2_INLINE const std::size_t& size() const noexcept
+    {
+      return _allocator.size();
+    }
+
+    /// 確保しているメモリの統計
+    ACCBOOST2_INLINE MEMORY::Statistics stats() const noexcept
+    {
+      return _allocator.stats();
+    }
+
+    /// 生成中の要素数が n に達するまで追加のメモリ確保が起きないようにする．
     ACCBOOST2_INLINE void reserve(std::size_t n)
     {
-      _allocator.expand(n);
+      if(n > _allocator.capacity()){
+        _allocator.expand(n - _allocator.capacity());
+      }
     }
 
     ACCBOOST2_INLINE void release() noexcept
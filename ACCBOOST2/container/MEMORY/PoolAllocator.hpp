@@ -4,6 +4,7 @@
 
 #include "../../utility.hpp"
 #include "allocate.hpp"
+#include "statistics.hpp"
 
 
 namespace ACCBOOST2::MEMORY
@@ -29,14 +30,17 @@ namespace ACCBOOST2::MEMORY
 
     Chunk** _table;
     std::size_t _table_size;
+    std::size_t _capacity;
     std::size_t _number_of_allocateds;
     Chunk* _first_empty_chunk;
+    [[no_unique_address]] MEMORY::Counter<PoolAllocator> _number_of_expansions;
 
   public:
 
     ACCBOOST2_INLINE PoolAllocator() noexcept:
       _table(nullptr),
       _table_size(0),
+      _capacity(0),
       _number_of_allocateds(0),
       _first_empty_chunk(nullptr)
     {}
@@ -44,11 +48,14 @@ namespace ACCBOOST2::MEMORY
     ACCBOOST2_INLINE PoolAllocator(PoolAllocator&& other) noexcept:
       _table(other._table),
       _table_size(other._table_size),
+      _capacity(other._capacity),
       _number_of_allocateds(other._number_of_allocateds),
-      _first_empty_chunk(other._first_empty_chunk)
+      _first_empty_chunk(other._first_empty_chunk),
+      _number_of_expansions(other._number_of_expansions)
     {
       other._table = nullptr;
       other._table_size = 0;
+      other._capacity = 0;
       other._number_of_allocateds = 0;
       other._first_empty_chunk = nullptr;
     }
@@ -65,10 +72,34 @@ namespace ACCBOOST2::MEMORY
       release();
     }
 
+    /// 確保済みのチャンク数
+    ACCBOOST2_INLINE const std::size_t& capacity() const noexcept
+    {
+      return _capacity;
+    }
+
+    /// 割り当て中のチャンク数
+    ACCBOOST2_INLINE const std::size_t& size() const noexcept
+    {
+      return _number_of_allocateds;
+    }
+
+    /// 確保しているメモリの統計
+    MEMORY::Statistics stats() const noexcept
+    {
+      MEMORY::Statistics result;
+      result.allocations = _number_of_expansions.value();
+      result.reserved_bytes = _capacity * sizeof(Chunk) + _table_size * sizeof(Chunk*);
+      result.live_bytes = _number_of_allocateds * sizeof(Chunk);
+      result.occupancy = _capacity == 0 ? 0.0 : static_cast<double>(_number_of_allocateds) / static_cast<double>(_capacity);
+      return result;
+    }
+
     ACCBOOST2_NOINLINE void expand(std::size_t n)
     {
       assert((_table == nullptr) == (_table_size == 0));
       if(n == 0) return;
+      ++_number_of_expansions;
       // 新たなメモリブロックを確保
       Chunk* new_chinks = MEMORY::allocate<Chunk, _alignment>(n);
       // メモリブロックの先頭ポインタを格納する配列を拡大
@@ -90,6 +121,7 @@ namespace ACCBOOST2::MEMORY
       new_table[_table_size] = new_chinks;
       _table = new_table;
       ++_table_size;
+      _capacity += n;
       // 空きリストに追加
       for(std::size_t i = 0; i < n - 1; ++i){
         (new_chinks + i)->next = new_chinks + i + 1;
@@ -137,6 +169,8 @@ namespace ACCBOOST2::MEMORY
         }
         MEMORY::deallocate(_table);
         _table = nullptr;
+        _capacity = 0;
+        _first_empty_chunk = nullptr;
       }
     }
 
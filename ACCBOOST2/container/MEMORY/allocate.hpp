@@ -20,7 +20,8 @@ namespace ACCBOOST2::MEMORY
     static_assert(Alignment != 0);
     static_assert((Alignment & (Alignment - 1U)) == 0);
     static_assert(Alignment % alignof(T) == 0);
-    void* pointer = std::aligned_alloc(Alignment, n * sizeof(T));
+    // note: aligned_alloc のサイズは Alignment の倍数でなければならない．
+    void* pointer = std::aligned_alloc(Alignment, (n * sizeof(T) + Alignment - 1) / Alignment * Alignment);
     if(pointer == nullptr) throw std::bad_alloc();
     assert(reinterpret_cast<std::intptr_t>(pointer) % Alignment == 0);
     return static_cast<T*>(pointer);
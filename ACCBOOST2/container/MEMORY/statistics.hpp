@@ -0,0 +1,252 @@
+#ifndef ACCBOOST2_CONTAINER_MEMORY_STATISTICS_HPP_
+#define ACCBOOST2_CONTAINER_MEMORY_STATISTICS_HPP_
+
+
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+
+
+namespace ACCBOOST2::MEMORY
+{
+
+
+  /**
+   * コンテナが保持しているメモリの統計．
+   * 回数を表す項目は ACCBOOST2_MEMORY_STATISTICS が定義されている場合のみ数え，定義されていない場合は常に 0 となる．
+   */
+  struct Statistics
+  {
+    /// ヒープからメモリを確保した回数
+    std::size_t allocations = 0;
+    /// 確保しているバイト数
+    std::size_t reserved_bytes = 0;
+    /// 確保しているうち，要素が使用しているバイト数
+    std::size_t live_bytes = 0;
+    /// ハッシュテーブルを再構築した回数
+    std::size_t rehashes = 0;
+    /// 格納されている要素を探索する際に調べるスロット数の平均
+    double average_probe_length = 0;
+    /// 格納されている要素を探索する際に調べるスロット数の最大
+    std::size_t max_probe_length = 0;
+    /// メモリプールのチャンクのうち使用中のものの割合
+    double occupancy = 0;
+  };
+
+
+#if defined(ACCBOOST2_MEMORY_STATISTICS)
+
+  /// 事象の回数を数えるカウンタ（OwnerType はカウンタを持つクラス）．
+  template<class OwnerType>
+  class Counter
+  {
+  private:
+
+    std::size_t _value = 0;
+
+  public:
+
+    void operator++() noexcept
+    {
+      ++_value;
+    }
+
+    std::size_t value() const noexcept
+    {
+      return _value;
+    }
+
+  };
+
+#else
+
+  /**
+   * ACCBOOST2_MEMORY_STATISTICS が定義されていない場合は何も数えない．
+   * 空のクラスとして [[no_unique_address]] で持たせるが，同じ型の空のメンバは同じアドレスに置けないため，
+   * 入れ子になったコンテナ（HashTable が持つ Array など）のカウンタとは OwnerType で型を区別する．
+   */
+  template<class OwnerType>
+  class Counter
+  {
+  public:
+
+    void operator++() noexcept
+    {}
+
+    std::size_t value() const noexcept
+    {
+      return 0;
+    }
+
+  };
+
+#endif
+
+
+  /**
+   * 統計を取得できるコンテナのインスタンスの一覧．
+   * ACCBOOST2_MEMORY_STATISTICS が定義されている場合に，Dictionary と Sparse2DArray が生成時に登録される．
+   */
+  class Registry
+  {
+  public:
+
+    /// 登録されるインスタンスごとの情報（侵入型の双方向リストのノード）．
+    class Node
+    {
+      friend class Registry;
+
+    private:
+
+      const char* _name = nullptr;
+      const void* _owner = nullptr;
+      Statistics (*_statistics)(const void*) = nullptr;
+      Node* _previous = nullptr;
+      Node* _next = nullptr;
+
+    protected:
+
+      Node() = default;
+
+      Node(const char* name, const void* owner, Statistics (*statistics)(const void*)) noexcept:
+        _name(name), _owner(owner), _statistics(statistics)
+      {}
+
+      ~Node() noexcept = default;
+
+    // deleted:
+
+      Node(Node&&) = delete;
+      Node(const Node&) = delete;
+      Node& operator=(Node&&) = delete;
+      Node& operator=(const Node&) = delete;
+
+    };
+
+  private:
+
+    std::mutex _mutex;
+    Node _header;
+
+    Registry() noexcept
+    {
+      _header._previous = &_header;
+      _header._next = &_header;
+    }
+
+  public:
+
+    static Registry& global() noexcept
+    {
+      static Registry registry;
+      return registry;
+    }
+
+    void add(Node* node) noexcept
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      node->_previous = _header._previous;
+      node->_next = &_header;
+      _header._previous->_next = node;
+      _header._previous = node;
+    }
+
+    void erase(Node* node) noexcept
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      node->_previous->_next = node->_next;
+      node->_next->_previous = node->_previous;
+      node->_previous = nullptr;
+      node->_next = nullptr;
+    }
+
+    /// 登録されているインスタンスの数
+    std::size_t size() noexcept
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      std::size_t n = 0;
+      for(Node* node = _header._next; node != &_header; node = node->_next){
+        ++n;
+      }
+      return n;
+    }
+
+    /// f(name, owner, statistics) を登録されている全てのインスタンスについて呼ぶ．
+    template<class F>
+    void for_each(F&& f)
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      for(Node* node = _header._next; node != &_header; node = node->_next){
+        f(node->_name, node->_owner, node->_statistics(node->_owner));
+      }
+    }
+
+    /// 登録されている全てのインスタンスの統計を 1 行ずつ出力する．
+    void report(std::ostream& stream)
+    {
+      stream << "name\towner\tallocations\treserved_bytes\tlive_bytes\trehashes\taverage_probe_length\tmax_probe_length\toccupancy\n";
+      for_each([&](const char* name, const void* owner, const Statistics& statistics)
+      {
+        stream << name << "\t" << owner
+          << "\t" << statistics.allocations
+          << "\t" << statistics.reserved_bytes
+          << "\t" << statistics.live_bytes
+          << "\t" << statistics.rehashes
+          << "\t" << statistics.average_probe_length
+          << "\t" << statistics.max_probe_length
+          << "\t" << statistics.occupancy
+          << "\n";
+      });
+      stream.flush();
+    }
+
+  };
+
+
+#if defined(ACCBOOST2_MEMORY_STATISTICS)
+
+  /// コンテナのメンバとして持たせ，コンテナの生存中は Registry に登録しておく．
+  template<class OwnerType>
+  class Registration: public Registry::Node
+  {
+  public:
+
+    Registration(const char* name, const OwnerType* owner) noexcept:
+      Registry::Node(name, owner, [](const void* p){return static_cast<const OwnerType*>(p)->stats();})
+    {
+      Registry::global().add(this);
+    }
+
+    ~Registration() noexcept
+    {
+      Registry::global().erase(this);
+    }
+
+  };
+
+#else
+
+  template<class OwnerType>
+  class Registration
+  {
+  public:
+
+    Registration(const char*, const OwnerType*) noexcept
+    {}
+
+  // deleted:
+
+    Registration(Registration&&) = delete;
+    Registration(const Registration&) = delete;
+    Registration& operator=(Registration&&) = delete;
+    Registration& operator=(const Registration&) = delete;
+
+  };
+
+#endif
+
+
+}
+
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef ACCBOOST2_CONTAINER_SPARSE_ASSEMBLY_FORWARDLIST_HPP_
+#define ACCBOOST2_CONTAINER_SPARSE_ASSEMBLY_FORWARDLIST_HPP_
+
+
+#include "../../utility.hpp"
+
+
+namespace ACCBOOST2::SPARSE_ASSEMBLY
+{
+
+
+/**
+ * List と同じインターフェースを持つ片方向リスト．
+ * 要素あたりのポインタが 1 つで済む代わりに，先頭以外の要素の erase はリスト長に比例する時間がかかる．
+ */
+class ForwardList
+{
+public:
+
+  class Item
+  {
+    friend class ForwardList;
+
+  private:
+
+    Item* _next_item;
+
+  protected:
+
+    Item() noexcept:
+      _next_item(nullptr)
+    {}
+
+    Item(Item&& other) noexcept:
+      _next_item(other._next_item)
+    {
+      other._next_item = nullptr;
+    }
+
+  // deleted:
+
+    Item(const Item&) = delete;
+    Item& operator=(Item&&) = delete;
+    Item& operator=(const Item&) = delete;
+
+  protected:
+
+    ~Item() noexcept = default;
+
+  };
+
+
+private:
+
+  class Header: public Item {};
+
+  Header _header;
+  Item* _last_item;
+  std::size_t _size;
+
+public:
+
+  ForwardList() noexcept:
+    _header(), _last_item(std::addressof(_header)), _size(0)
+  {}
+
+  ForwardList(ForwardList&& other) noexcept:
+    _header(), _last_item(std::addressof(_header)), _size(0)
+  {
+    if(other._size != 0){
+      _header._next_item = other._header._next_item;
+      _last_item = other._last_item;
+      _size = other._size;
+      //
+      other._header._next_item = nullptr;
+      other._last_item = std::addressof(other._header);
+      other._size = 0;
+    }
+  }
+
+  ~ForwardList() noexcept
+  {
+    assert(_size == 0);
+  }
+
+// deleted:
+
+  ForwardList(const ForwardList&) = delete;
+  ForwardList& operator=(ForwardList&&) = delete;
+  ForwardList& operator=(const ForwardList&) = delete;
+
+public:
+
+  const std::size_t& size() const noexcept
+  {
+    return _size;
+  }
+
+private:
+
+  template<class T>
+  class Iterator
+  {
+    friend class ForwardList;
+
+  public:
+
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+    using reference = T*;
+    using value_type = T*;
+    using pointer = T**;
+
+  private:
+
+    T* _item = nullptr;
+
+    explicit Iterator(T* item) noexcept:
+      _item(item)
+    {}
+
+  public:
+
+    Iterator() = default;
+    Iterator(Iterator&&) = default;
+    Iterator(const Iterator&) = default;
+    Iterator& operator=(Iterator&&) = default;
+    Iterator& operator=(const Iterator&) = default;
+
+    template<class U>
+    bool operator==(const Iterator<U>& rhs) const noexcept
+    {
+      return _item == rhs._item;
+    }
+
+    template<class U>
+    bool operator!=(const Iterator<U>& rhs) const noexcept
+    {
+      return !operator==(rhs);
+    }
+
+    T* operator*() const noexcept
+    {
+      return _item;
+    }
+
+    Iterator& operator++() noexcept
+    {
+      _item = _item->_next_item;
+      return *this;
+    }
+
+    Iterator operator++(int) noexcept
+    {
+      Iterator tmp(*this);
+      operator++();
+      return tmp;
+    }
+
+  };
+
+public:
+
+  decltype(auto) begin() noexcept
+  {
+    return Iterator<Item>(_header._next_item);
+  }
+
+  decltype(auto) end() noexcept
+  {
+    return Iterator<Item>(nullptr);
+  }
+
+  decltype(auto) begin() const noexcept
+  {
+    return Iterator<const Item>(_header._next_item);
+  }
+
+  decltype(auto) end() const noexcept
+  {
+    return Iterator<const Item>(nullptr);
+  }
+
+  const Item* front() const noexcept
+  {
+    return _header._next_item;
+  }
+
+  Item* front() noexcept
+  {
+    return _header._next_item;
+  }
+
+  /// 全ての要素が既に破棄されている場合に，要素を辿らずにリストを空にする．
+  void reset() noexcept
+  {
+    _header._next_item = nullptr;
+    _last_item = std::addressof(_header);
+    _size = 0;
+  }
+
+  void push_front(Item* item) noexcept
+  {
+    assert(item != nullptr);
+    assert(item->_next_item == nullptr);
+    item->_next_item = _header._next_item;
+    _header._next_item = item;
+    if(_last_item == std::addressof(_header)){
+      _last_item = item;
+    }
+    ++_size;
+  }
+
+  void push_back(Item* item) noexcept
+  {
+    assert(item != nullptr);
+    assert(item->_next_item == nullptr);
+    _last_item->_next_item = item;
+    _last_item = item;
+    ++_size;
+  }
+
+  Iterator<Item> erase(Item* item) noexcept
+  {
+    assert(item != nullptr);
+    assert(_size != 0);
+    // 直前の要素を探す
+    Item* previous_item = std::addressof(_header);
+    while(previous_item->_next_item != item){
+      assert(previous_item->_next_item != nullptr);
+      previous_item = previous_item->_next_item;
+    }
+    Item* next_item = item->_next_item;
+    previous_item->_next_item = next_item;
+    if(_last_item == item){
+      _last_item = previous_item;
+    }
+    --_size;
+    item->_next_item = nullptr;
+    return Iterator<Item>(next_item);
+  }
+
+};
+
+
+}
+
+
+#endif
@@ -27,6 +27,16 @@ protected:
 };
 
 
+/// HashTable の探索長の統計
+struct ProbeStatistics
+{
+  /// 格納されている要素を探索する際に調べるスロット数の平均
+  double average_probe_length = 0;
+  /// 格納されている要素を探索する際に調べるスロット数の最大
+  std::size_t max_probe_length = 0;
+};
+
+
 template<class GetKey, class Hash>
 class HashTable
 {
@@ -121,6 +131,7 @@ private:
   Array<Slot> _table;
   std::size_t _number_of_used;
   std::size_t _number_of_dirty;
+  [[no_unique_address]] MEMORY::Counter<HashTable> _number_of_rehashes;
 
 public:
 
@@ -138,6 +149,7 @@ public:
     swap(_table, other._table);
     swap(_number_of_used, other._number_of_used);
     swap(_number_of_dirty, other._number_of_dirty);
+    swap(_number_of_rehashes, other._number_of_rehashes);
   }
 
 // deleted:
@@ -153,6 +165,60 @@ public:
     return _number_of_used;
   }
 
+  std::size_t bucket_count() const noexcept
+  {
+    return _table.size();
+  }
+
+  double load_factor() const noexcept
+  {
+    if(_table.size() != 0){
+      return static_cast<double>(_number_of_used) / static_cast<double>(_table.size());
+    }else{
+      return 0;
+    }
+  }
+
+  /// 全ての要素について探索列を辿り直して探索長を集計する．要素数に比例する時間がかかる．
+  ProbeStatistics probe_statistics() const noexcept
+  {
+    ProbeStatistics statistics;
+    if(_number_of_used == 0) return statistics;
+    std::size_t position_mask = _table.size() - 1U;
+    std::size_t total_probe_length = 0;
+    for(std::size_t position = 0; position < _table.size(); ++position){
+      const Slot& slot = _table[position];
+      if(!slot.is_used()) continue;
+      // _search と同じ順序でスロットを辿る
+      std::size_t probe_length = 1;
+      std::size_t current_position = slot.hash_value();
+      std::size_t perturb = slot.hash_value();
+      while((current_position & position_mask) != position){
+        perturb >>= 5;
+        current_position = (current_position & position_mask) * 5 + perturb + 1;
+        ++probe_length;
+      }
+      total_probe_length += probe_length;
+      statistics.max_probe_length = std::max(statistics.max_probe_length, probe_length);
+    }
+    statistics.average_probe_length = static_cast<double>(total_probe_length) / static_cast<double>(_number_of_used);
+    return statistics;
+  }
+
+  /// 確保しているメモリの統計．探索長の集計を含むため，要素数に比例する時間がかかる．
+  MEMORY::Statistics stats() const noexcept
+  {
+    MEMORY::Statistics result;
+    result.allocations = _number_of_rehashes.value();
+    result.reserved_bytes = _table.capacity() * sizeof(Slot);
+    result.live_bytes = _number_of_used * sizeof(Slot);
+    result.rehashes = _number_of_rehashes.value();
+    ProbeStatistics probe = probe_statistics();
+    result.average_probe_length = probe.average_probe_length;
+    result.max_probe_length = probe.max_probe_length;
+    return result;
+  }
+
 private:
 
   template<class K>
@@ -207,6 +273,7 @@ private:
       old_table.push_back();
     }
     // NOTE これ以降例外は投げられない
+    ++_number_of_rehashes;
     // テーブルを退避
     swap(old_table, _table);
     _number_of_used = 0;
@@ -228,6 +295,15 @@ private:
 
 public:
 
+  /// 要素数が n に達するまでテーブルの拡張が起きないようにする．
+  void reserve(std::size_t n)
+  {
+    n = std::max(n, _number_of_used);
+    if(n + _number_of_dirty > _table.size() / 2){
+      _reserve(std::max(n * 2, _min_table_size));
+    }
+  }
+
   template<class K>
   ACCBOOST2_INLINE const HashTableItem* get(const K& key) const noexcept
   {
@@ -264,19 +340,55 @@ public:
     }
   }
 
-  ACCBOOST2_INLINE void add(HashTableItem* item)
+  /// search_for_add で得られる挿入位置．テーブルが変更されるまでの間のみ有効．
+  class AddPosition
+  {
+    friend class HashTable;
+
+  private:
+
+    std::size_t _hash_value;
+    std::size_t _position;
+
+    AddPosition(const std::size_t& hash_value, const std::size_t& position) noexcept:
+      _hash_value(hash_value), _position(position)
+    {}
+
+  };
+
+  /**
+   * key を探索し，見つかればその要素を，見つからなければ nullptr を返す．
+   * 見つからなかった場合は，返された AddPosition を add に渡すことで再探索せずに要素を追加できる．
+   * 追加に備えて，必要ならば探索前にテーブルを拡張する．
+   */
+  template<class K>
+  ACCBOOST2_INLINE std::tuple<HashTableItem*, AddPosition> search_for_add(const K& key)
   {
-    assert(item != nullptr);
     if(_number_of_used + _number_of_dirty >= _table.size() / 2) [[unlikely]] {
       _reserve(std::max(_number_of_used * 4, _min_table_size));
     }
-    std::size_t hash_value = _hash(_get_key(*item));
-    std::size_t position = _search(hash_value, _get_key(*item));
+    std::size_t hash_value = _hash(key);
+    std::size_t position = _search(hash_value, key);
     assert(position < _table.size());
-    Slot& slot = _table[position];
+    const Slot& slot = _table[position];
+    if(slot.is_used()){
+      return {slot.item(), AddPosition(hash_value, position)};
+    }else{
+      return {nullptr, AddPosition(hash_value, position)};
+    }
+  }
+
+  /// search_for_add で見つからなかった key を持つ item を，再探索せずに追加する．
+  ACCBOOST2_INLINE void add(const AddPosition& add_position, HashTableItem* item) noexcept
+  {
+    assert(item != nullptr);
+    assert(add_position._position < _table.size());
+    assert(add_position._hash_value == _hash(_get_key(*item)));
+    assert(_search(add_position._hash_value, _get_key(*item)) == add_position._position);
+    Slot& slot = _table[add_position._position];
     assert(!slot.is_used());
     bool was_dirty = slot.is_dirty();
-    slot.set_to_used(hash_value, item);
+    slot.set_to_used(add_position._hash_value, item);
     if(was_dirty){
       assert(_number_of_dirty != 0);
       _number_of_dirty -= 1;
@@ -284,6 +396,14 @@ public:
     _number_of_used += 1;
   }
 
+  ACCBOOST2_INLINE void add(HashTableItem* item)
+  {
+    assert(item != nullptr);
+    auto [found_item, add_position] = search_for_add(_get_key(*item));
+    assert(found_item == nullptr); static_cast<void>(found_item);
+    add(add_position, item);
+  }
+
   ACCBOOST2_INLINE void erase(HashTableItem* item) noexcept
   {
     assert(item != nullptr);
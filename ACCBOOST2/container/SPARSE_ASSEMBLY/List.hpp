@@ -249,6 +249,14 @@ public:
     }
   }
 
+  /// 全ての要素が既に破棄されている場合に，要素を辿らずにリストを空にする．
+  void reset() noexcept
+  {
+    _header._previous_item = std::addressof(_header);
+    _header._next_item = std::addressof(_header);
+    _size = 0;
+  }
+
   void push_front(Item* item) noexcept
   {
     insert(begin(), item);
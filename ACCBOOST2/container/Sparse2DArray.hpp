@@ -2,9 +2,11 @@
 #define ACCBOOST2_CONTAINER_SPARSE_SPARSE2DARRAY_HPP_
 
 
+#include <functional>
 #include "Array.hpp"
 #include "MEMORY/MemoryPool.hpp"
 #include "SPARSE_ASSEMBLY/List.hpp"
+#include "SPARSE_ASSEMBLY/ForwardList.hpp"
 #include "SPARSE_ASSEMBLY/HashTable.hpp"
 
 
@@ -12,18 +14,31 @@ namespace ACCBOOST2
 {
 
 
-template<class ValueType>
+/**
+ * 行方向・列方向の連結リストとハッシュテーブルによる疎な 2 次元配列．
+ * ListType に SPARSE_ASSEMBLY::ForwardList を指定すると要素あたりのポインタが 4 つから 2 つに減る代わりに，
+ * erase, clear_row, clear_column で別方向のリストを先頭から辿るようになる．
+ * IndexType は要素が保持する行・列番号の型で，std::uint32_t を指定すると要素とハッシュキーが小さくなる．
+ */
+template<class ValueType, class ListType = SPARSE_ASSEMBLY::List, class IndexType = std::size_t>
 class Sparse2DArray
 {
+  static_assert(std::is_unsigned_v<IndexType>);
+  static_assert(sizeof(IndexType) <= sizeof(std::size_t));
+
+public:
+
+  using index_type = IndexType;
+
 private:
 
   using DirectionType = enum {ROW = 0, COLUMN = 1};
 
-  using index_pair_type = std::array<std::size_t, 2>;
+  using index_pair_type = std::array<IndexType, 2>;
 
-  class RowListItem: public SPARSE_ASSEMBLY::List::Item {};
+  class RowListItem: public ListType::Item {};
 
-  class ColumnListItem: public SPARSE_ASSEMBLY::List::Item {};
+  class ColumnListItem: public ListType::Item {};
 
   using ListItems = std::tuple<RowListItem, ColumnListItem>;
 
@@ -37,17 +52,23 @@ private:
   public:
 
     template<class V>
-    Item(const std::size_t& row_index, const std::size_t& column_index, V&& value):
+    Item(const IndexType& row_index, const IndexType& column_index, V&& value):
       RowListItem(), ColumnListItem(), HashTableItem(),
       _indices{row_index, column_index}, _value(std::forward<V>(value))
     {}
 
-    const std::size_t& row_index() const noexcept
+    template<class... Args>
+    Item(std::in_place_t, const IndexType& row_index, const IndexType& column_index, Args&&... args):
+      RowListItem(), ColumnListItem(), HashTableItem(),
+      _indices{row_index, column_index}, _value(std::forward<Args>(args)...)
+    {}
+
+    const IndexType& row_index() const noexcept
     {
       return ACCBOOST2::get<ROW>(_indices);
     }
 
-    const std::size_t& column_index() const noexcept
+    const IndexType& column_index() const noexcept
     {
       return ACCBOOST2::get<COLUMN>(_indices);
     }
@@ -82,7 +103,13 @@ private:
 
     std::size_t operator()(const index_pair_type& index) const noexcept
     {
-      std::uint64_t h = (ACCBOOST2::get<ROW>(index) << 32) + (ACCBOOST2::get<ROW>(index) >> 32) + ACCBOOST2::get<COLUMN>(index);
+      std::uint64_t h;
+      if constexpr (sizeof(IndexType) <= 4){
+        // 2 つの番号を 64 bit に詰める
+        h = (static_cast<std::uint64_t>(ACCBOOST2::get<ROW>(index)) << 32) | static_cast<std::uint64_t>(ACCBOOST2::get<COLUMN>(index));
+      }else{
+        h = (ACCBOOST2::get<ROW>(index) << 32) + (ACCBOOST2::get<ROW>(index) >> 32) + ACCBOOST2::get<COLUMN>(index);
+      }
       h ^= h >> 23;
       h *= 0x2127599bf4325c37ULL;
       h ^= h >> 47;
@@ -92,21 +119,35 @@ private:
 
   using HashTable = SPARSE_ASSEMBLY::HashTable<GetKey, HashFunction>;
 
+  static index_pair_type _make_indices(const std::size_t row_index, const std::size_t column_index) noexcept
+  {
+    assert(row_index <= std::numeric_limits<IndexType>::max());
+    assert(column_index <= std::numeric_limits<IndexType>::max());
+    return {static_cast<IndexType>(row_index), static_cast<IndexType>(column_index)};
+  }
+
 private:
 
   MEMORY::MemoryPool<Item> _memory_pool;
-  std::array<Array<SPARSE_ASSEMBLY::List>, 2> _list_headers;
+  std::array<Array<ListType>, 2> _list_headers;
   HashTable _hash_table;
+  [[no_unique_address]] MEMORY::Registration<Sparse2DArray> _registration{"Sparse2DArray", this};
 
 public:
 
   Sparse2DArray() = default;
 
-  Sparse2DArray(Sparse2DArray&&) = default;
+  Sparse2DArray(Sparse2DArray&& other) noexcept:
+    _memory_pool(std::move(other._memory_pool)),
+    _list_headers(std::move(other._list_headers)),
+    _hash_table(std::move(other._hash_table))
+  {}
 
   Sparse2DArray(const std::size_t& row_size, const std::size_t& column_size):
     _memory_pool(), _list_headers(), _hash_table()
   {
+    assert(row_size == 0 || row_size - 1 <= std::numeric_limits<IndexType>::max());
+    assert(column_size == 0 || column_size - 1 <= std::numeric_limits<IndexType>::max());
     _list_headers[ROW].resize(row_size);
     _list_headers[COLUMN].resize(column_size);
   }
@@ -142,6 +183,7 @@ private:
   template<DirectionType Direction>
   ACCBOOST2_NOINLINE void _resize(const std::size_t& size)
   {
+    assert(size == 0 || size - 1 <= std::numeric_limits<IndexType>::max());
     if(_list_headers[Direction].size() < size){
       do{
         _list_headers[Direction].push_back();
@@ -174,8 +216,8 @@ private:
     assert(index < _list_headers[D].size());
     auto& list = _list_headers[D][index];
     while(list.size() != 0){
-      // リストの末尾要素を取得
-      Item* item = static_cast<Item*>(static_cast<ACCBOOST2::tuple_element_t<D, ListItems>*>(list.back()));
+      // リストの先頭要素を取得
+      Item* item = static_cast<Item*>(static_cast<ACCBOOST2::tuple_element_t<D, ListItems>*>(list.front()));
       assert(ACCBOOST2::get<D>(item->indices()) == index);
       // リストから削除
       list.erase(static_cast<ACCBOOST2::tuple_element_t<D, ListItems>*>(item));
@@ -204,18 +246,21 @@ public:
 
   ACCBOOST2_NOINLINE void clear() noexcept
   {
+    // 全ての要素を破棄するので，リストからは個別に削除せずにまとめて空にする
     for(std::size_t row_index: ACCBOOST2::reverse(ACCBOOST2::range(_list_headers[ROW].size()))){
       auto& row_list = _list_headers[ROW][row_index];
-      while(row_list.size() != 0){
-        Item* item = static_cast<Item*>(static_cast<RowListItem*>(row_list.back()));
-        assert(item->row_index() == row_index);      
+      for(auto iterator = row_list.begin(); iterator != row_list.end(); ){
+        Item* item = static_cast<Item*>(static_cast<RowListItem*>(*iterator));
+        ++iterator;
+        assert(item->row_index() == row_index);
         assert(item->column_index() < _list_headers[COLUMN].size());
-        auto& column_list = _list_headers[COLUMN][item->column_index()];
-        row_list.erase(static_cast<RowListItem*>(item));
-        column_list.erase(static_cast<ColumnListItem*>(item));
         _hash_table.erase(item);
         _memory_pool.destroy(item);
       }
+      row_list.reset();
+    }
+    for(auto& column_list: _list_headers[COLUMN]){
+      column_list.reset();
     }
   }
 
@@ -227,9 +272,49 @@ public:
     _memory_pool.release();
   }
 
+  /// n 個の非ゼロ要素を格納するまで追加のメモリ確保やハッシュテーブルの再構築が起きないようにする．
+  void reserve(std::size_t n)
+  {
+    _memory_pool.reserve(n);
+    _hash_table.reserve(n);
+  }
+
+  std::size_t bucket_count() const noexcept
+  {
+    return _hash_table.bucket_count();
+  }
+
+  double load_factor() const noexcept
+  {
+    return _hash_table.load_factor();
+  }
+
+  SPARSE_ASSEMBLY::ProbeStatistics probe_statistics() const noexcept
+  {
+    return _hash_table.probe_statistics();
+  }
+
+  /// メモリプール，行・列のリストの先頭，ハッシュテーブルが確保しているメモリの統計
+  MEMORY::Statistics stats() const noexcept
+  {
+    MEMORY::Statistics result = _hash_table.stats();
+    const MEMORY::Statistics pool = _memory_pool.stats();
+    result.allocations += pool.allocations;
+    result.reserved_bytes += pool.reserved_bytes;
+    result.live_bytes += pool.live_bytes;
+    result.occupancy = pool.occupancy;
+    for(const auto& list_headers: _list_headers){
+      const MEMORY::Statistics headers = list_headers.stats();
+      result.allocations += headers.allocations;
+      result.reserved_bytes += headers.reserved_bytes;
+      result.live_bytes += headers.live_bytes;
+    }
+    return result;
+  }
+
   bool contain(const std::size_t row_index, const std::size_t column_index) const noexcept
   {
-    Item* item = static_cast<Item*>(_hash_table.get(std::array{row_index, column_index}));
+    const Item* item = static_cast<const Item*>(_hash_table.get(_make_indices(row_index, column_index)));
     if(item != nullptr){
       assert(item->row_index() == row_index);
       assert(item->column_index() == column_index);
@@ -241,7 +326,7 @@ public:
 
   ValueType& get(const std::size_t row_index, const std::size_t column_index) noexcept
   {
-    Item* item = static_cast<Item*>(_hash_table.get(std::array{row_index, column_index}));
+    Item* item = static_cast<Item*>(_hash_table.get(_make_indices(row_index, column_index)));
     assert(item != nullptr);
     assert(item->row_index() == row_index);
     assert(item->column_index() == column_index);
@@ -250,7 +335,7 @@ public:
 
   const ValueType& get(const std::size_t row_index, const std::size_t column_index) const noexcept
   {
-    const Item* item = static_cast<const Item*>(_hash_table.get(std::array{row_index, column_index}));
+    const Item* item = static_cast<const Item*>(_hash_table.get(_make_indices(row_index, column_index)));
     assert(item != nullptr);
     assert(item->row_index() == row_index);
     assert(item->column_index() == column_index);
@@ -261,7 +346,7 @@ public:
   const ValueType& get(const std::size_t row_index, const std::size_t column_index, DefaultValueType&& default_value) const noexcept
   {
     static_assert(std::is_lvalue_reference_v<DefaultValueType>);
-    const Item* item = static_cast<const Item*>(_hash_table.get(std::array{row_index, column_index}));
+    const Item* item = static_cast<const Item*>(_hash_table.get(_make_indices(row_index, column_index)));
     if(item != nullptr){
       assert(item->row_index() == row_index);
       assert(item->column_index() == column_index);
@@ -271,36 +356,83 @@ public:
     }
   }
 
+private:
+
+  /// search_for_add で得た位置に要素を追加する．
+  template<class... Args>
+  Item* _add(const typename HashTable::AddPosition& add_position, const std::size_t row_index, const std::size_t column_index, Args&&... args)
+  {
+    Item* item = _memory_pool.create(std::in_place, static_cast<IndexType>(row_index), static_cast<IndexType>(column_index), std::forward<Args>(args)...);
+    assert(item->row_index() == row_index);
+    assert(item->column_index() == column_index);
+    // NOTE これ以降例外は投げられない
+    _list_headers[ROW][row_index].push_back(static_cast<RowListItem*>(item));
+    _list_headers[COLUMN][column_index].push_back(static_cast<ColumnListItem*>(item));
+    _hash_table.add(add_position, item);
+    return item;
+  }
+
+public:
+
   template<class V>
   void emplace(const std::size_t row_index, const std::size_t column_index, V&& value)
   {
     assert(row_index < _list_headers[ROW].size());
     assert(column_index < _list_headers[COLUMN].size());
-    Item* item = static_cast<Item*>(_hash_table.get(std::array{row_index, column_index}));
-    if(item != nullptr){
-      item->value() = std::forward<V>(value);
+    auto [found_item, add_position] = _hash_table.search_for_add(_make_indices(row_index, column_index));
+    if(found_item != nullptr){
+      static_cast<Item*>(found_item)->value() = std::forward<V>(value);
     }else{
-      item = _memory_pool.create(row_index, column_index, std::forward<V>(value));
-      assert(item->row_index() == row_index);
-      assert(item->column_index() == column_index);
-      try{
-        _list_headers[ROW][row_index].push_back(static_cast<RowListItem*>(item));
-        try{
-          _list_headers[COLUMN][column_index].push_back(static_cast<ColumnListItem*>(item));
-          try{
-            _hash_table.add(item);
-          }catch(...){
-            _list_headers[COLUMN][column_index].erase(static_cast<ColumnListItem*>(item));
-            throw;
-          }
-        }catch(...){
-          _list_headers[ROW][row_index].erase(static_cast<RowListItem*>(item));
-          throw;
-        }
-      }catch(...){
-        _memory_pool.destroy(item);
-        throw;
-      }
+      _add(add_position, row_index, column_index, std::forward<V>(value));
+    }
+  }
+
+  /**
+   * (row_index, column_index) に要素が存在しなければ args から値を構築して追加し，存在すれば何もしない．
+   * 値への参照と，追加したか否かの組を返す．
+   */
+  template<class... Args>
+  std::tuple<ValueType&, bool> try_emplace(const std::size_t row_index, const std::size_t column_index, Args&&... args)
+  {
+    assert(row_index < _list_headers[ROW].size());
+    assert(column_index < _list_headers[COLUMN].size());
+    auto [found_item, add_position] = _hash_table.search_for_add(_make_indices(row_index, column_index));
+    if(found_item != nullptr){
+      return {static_cast<Item*>(found_item)->value(), false};
+    }else{
+      return {_add(add_position, row_index, column_index, std::forward<Args>(args)...)->value(), true};
+    }
+  }
+
+  /**
+   * (row_index, column_index) に要素が存在しなければ値を既定構築して追加した上で，値に f を適用する．
+   * f の戻り値は無視され，値への参照を返す．
+   */
+  template<class F>
+  requires(
+    std::is_default_constructible_v<ValueType> &&
+    std::invocable<F&&, ValueType&>
+  )
+  ValueType& emplace_or_update(const std::size_t row_index, const std::size_t column_index, F&& f)
+  {
+    ValueType& value = ACCBOOST2::get<0>(try_emplace(row_index, column_index));
+    std::invoke(std::forward<F>(f), value);
+    return value;
+  }
+
+  /// (row_index, column_index) に要素が存在しなければ value を追加し，存在すれば値に value を加える．
+  template<class V>
+  ValueType& accumulate(const std::size_t row_index, const std::size_t column_index, V&& value)
+  {
+    assert(row_index < _list_headers[ROW].size());
+    assert(column_index < _list_headers[COLUMN].size());
+    auto [found_item, add_position] = _hash_table.search_for_add(_make_indices(row_index, column_index));
+    if(found_item != nullptr){
+      ValueType& found_value = static_cast<Item*>(found_item)->value();
+      found_value += std::forward<V>(value);
+      return found_value;
+    }else{
+      return _add(add_position, row_index, column_index, std::forward<V>(value))->value();
     }
   }
 
@@ -308,7 +440,7 @@ public:
   {
     assert(row_index < _list_headers[ROW].size());
     assert(column_index < _list_headers[COLUMN].size());
-    Item* item = static_cast<Item*>(_hash_table.get(std::array{row_index, column_index}));
+    Item* item = static_cast<Item*>(_hash_table.get(_make_indices(row_index, column_index)));
     if(item != nullptr){
       assert(item->row_index() == row_index);
       assert(item->column_index() == column_index);
@@ -337,13 +469,13 @@ private:
     struct ItemToTuple
     {
 
-      decltype(auto) operator()(SPARSE_ASSEMBLY::List::Item* list_item) const noexcept
+      decltype(auto) operator()(typename ListType::Item* list_item) const noexcept
       {
         Item* item = static_cast<Item*>(static_cast<ListItem*>(list_item));
         return std::forward_as_tuple(item->row_index(), item->column_index(), item->value());
       }
 
-      decltype(auto) operator()(const SPARSE_ASSEMBLY::List::Item* list_item) const noexcept
+      decltype(auto) operator()(const typename ListType::Item* list_item) const noexcept
       {
         const Item* item = static_cast<const Item*>(static_cast<const ListItem*>(list_item));
         return std::forward_as_tuple(item->row_index(), item->column_index(), item->value());
@@ -394,7 +526,7 @@ private:
 
     void clear() noexcept requires(!std::is_const_v<Sparse2DArrayType>)
     {
-      _sparse_2d_array. template clear<Direction>(_index);
+      _sparse_2d_array. template _clear<Direction>(_index);
     }
 
   };
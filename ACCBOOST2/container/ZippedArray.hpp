@@ -115,6 +115,19 @@ namespace ACCBOOST2
       return map([&](const auto* p) -> decltype(auto) {return p[i];}, _pointers);
     }
 
+    /// I 番目の列の先頭（各列は連続した領域に置かれる）．
+    template<std::size_t I>
+    auto* data() noexcept
+    {
+      return ACCBOOST2::get<I>(_pointers);
+    }
+
+    template<std::size_t I>
+    const auto* data() const noexcept
+    {
+      return ACCBOOST2::get<I>(_pointers);
+    }
+
     decltype(auto) begin() noexcept
     {
       return ACCBOOST2::apply(
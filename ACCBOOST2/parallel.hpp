@@ -0,0 +1,12 @@
+#ifndef ACCBOOST2_PARALLEL_HPP_
+#define ACCBOOST2_PARALLEL_HPP_
+
+
+#include "parallel/ThreadPool.hpp"
+#include "parallel/parallel_for_each.hpp"
+#include "parallel/parallel_for_rows.hpp"
+#include "parallel/parallel_reduce.hpp"
+#include "parallel/parallel_transform_into.hpp"
+
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef ACCBOOST2_PARALLEL_THREADPOOL_HPP_
+#define ACCBOOST2_PARALLEL_THREADPOOL_HPP_
+
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "../container/Array.hpp"
+
+
+namespace ACCBOOST2
+{
+
+
+/**
+ * ワークスティーリング型のスレッドプール．
+ * ワーカーごとにタスクのキューを持ち，自分のキューが空になると他のキューの先頭からタスクを盗む．
+ * run を呼んだスレッドも完了を待つ間にタスクを実行するので，タスクの中から run を呼んでもデッドロックしない．
+ */
+class ThreadPool
+{
+private:
+
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  /// run 1 回分のタスクの集まり
+  struct TaskGroup
+  {
+    std::atomic<std::size_t> number_of_remainings;
+    std::mutex mutex;
+    std::exception_ptr exception;
+  };
+
+  // note: _queues[0] は run を呼んだスレッドのためのキュー，_queues[i + 1] は _threads[i] のためのキュー．
+  std::unique_ptr<Queue[]> _queues;
+  std::size_t _number_of_queues;
+  Array<std::thread> _threads;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::atomic<std::size_t> _number_of_tasks;
+  bool _stop;
+
+public:
+
+  /// number_of_threads は run を呼んだスレッドを含むスレッド数（0 ならばハードウェアのスレッド数）．
+  explicit ThreadPool(std::size_t number_of_threads = 0):
+    _queues(), _number_of_queues(0), _threads(), _mutex(), _condition(), _number_of_tasks(0), _stop(false)
+  {
+    if(number_of_threads == 0){
+      number_of_threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    _number_of_queues = number_of_threads;
+    _queues = std::make_unique<Queue[]>(_number_of_queues);
+    _threads.reserve(number_of_threads - 1);
+    try{
+      for(std::size_t i = 1; i < number_of_threads; ++i){
+        _threads.push_back([this, i](){_work(i);});
+      }
+    }catch(...){
+      _join();
+      throw;
+    }
+  }
+
+  ~ThreadPool() noexcept
+  {
+    _join();
+  }
+
+  /// プロセス全体で共有するスレッドプール
+  static ThreadPool& global()
+  {
+    static ThreadPool thread_pool;
+    return thread_pool;
+  }
+
+  /// run を呼んだスレッドを含むスレッド数
+  std::size_t concurrency() const noexcept
+  {
+    return _number_of_queues;
+  }
+
+  /**
+   * f(0), f(1), ..., f(n - 1) を並列に実行し，全ての完了を待つ．
+   * いずれかが例外を投げた場合は，全ての完了を待ってから最初の例外を投げ直す．
+   */
+  template<class F>
+  void run(std::size_t n, F&& f)
+  {
+    if(n == 0) return;
+    if(n == 1 || _number_of_queues == 1){
+      for(std::size_t k = 0; k < n; ++k){
+        f(k);
+      }
+      return;
+    }
+    TaskGroup group;
+    group.number_of_remainings.store(n);
+    for(std::size_t k = 0; k < n; ++k){
+      // note: 連続するタスクは同じキューに入れ，盗まれない限りは同じスレッドで実行されるようにする．
+      Queue& queue = _queues[k * _number_of_queues / n];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.emplace_back([&group, &f, k]()
+      {
+        try{
+          f(k);
+        }catch(...){
+          std::lock_guard<std::mutex> lock(group.mutex);
+          if(group.exception == nullptr) group.exception = std::current_exception();
+        }
+        group.number_of_remainings.fetch_sub(1, std::memory_order_acq_rel);
+      });
+    }
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _number_of_tasks.fetch_add(n, std::memory_order_release);
+    }
+    _condition.notify_all();
+    // 完了を待つ間もタスクを実行する
+    while(group.number_of_remainings.load(std::memory_order_acquire) != 0){
+      if(!_execute_one(0)){
+        std::this_thread::yield();
+      }
+    }
+    if(group.exception != nullptr){
+      std::rethrow_exception(group.exception);
+    }
+  }
+
+  /**
+   * [0, n) を連続するブロックに分割し，f(first, last) を並列に実行する．
+   * ブロック数はスレッド数の数倍とし，処理時間の偏りはワークスティーリングで均す．
+   */
+  template<class F>
+  void run_blocks(std::size_t n, F&& f)
+  {
+    const std::size_t number_of_blocks = std::min(n, _number_of_queues * 8);
+    run(number_of_blocks, [&](std::size_t block)
+    {
+      f(block * n / number_of_blocks, (block + 1) * n / number_of_blocks);
+    });
+  }
+
+private:
+
+  /// 自分のキューの末尾，または他のキューの先頭からタスクを 1 つ取り出して実行する．
+  bool _execute_one(std::size_t queue_index)
+  {
+    std::function<void()> task;
+    {
+      Queue& queue = _queues[queue_index];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if(!queue.tasks.empty()){
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      }
+    }
+    for(std::size_t i = 1; task == nullptr && i < _number_of_queues; ++i){
+      Queue& queue = _queues[(queue_index + i) % _number_of_queues];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if(!queue.tasks.empty()){
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+    }
+    if(task == nullptr) return false;
+    _number_of_tasks.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+  }
+
+  void _work(std::size_t queue_index)
+  {
+    while(true){
+      if(_execute_one(queue_index)) continue;
+      std::unique_lock<std::mutex> lock(_mutex);
+      _condition.wait(lock, [&](){return _stop || _number_of_tasks.load(std::memory_order_acquire) != 0;});
+      if(_stop) return;
+    }
+  }
+
+  void _join() noexcept
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stop = true;
+    }
+    _condition.notify_all();
+    for(auto& thread: _threads){
+      if(thread.joinable()) thread.join();
+    }
+    _threads.clear();
+  }
+
+// deleted:
+
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+};
+
+
+}
+
+
+#endif
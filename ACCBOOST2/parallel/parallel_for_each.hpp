@@ -0,0 +1,72 @@
+#ifndef ACCBOOST2_PARALLEL_PARALLEL_FOR_EACH_HPP_
+#define ACCBOOST2_PARALLEL_PARALLEL_FOR_EACH_HPP_
+
+
+#include "../utility.hpp"
+#include "ThreadPool.hpp"
+
+
+namespace ACCBOOST2
+{
+
+  /// x の各要素に f を並列に適用する．x はランダムアクセス可能で，end() - begin() で長さが求まること．
+  template<class F, class X>
+  requires(
+    std::ranges::random_access_range<X> &&
+    std::sized_sentinel_for<std::ranges::sentinel_t<X>, std::ranges::iterator_t<X>>
+  )
+  void parallel_for_each(F&& f, X&& x, ThreadPool& thread_pool = ThreadPool::global())
+  {
+    using std::begin;
+    using std::end;
+    const auto first = begin(x);
+    const std::ptrdiff_t n = end(x) - first;
+    if(n <= 0) return;
+    thread_pool.run_blocks(static_cast<std::size_t>(n), [&](std::size_t block_first, std::size_t block_last)
+    {
+      auto iterator = first + static_cast<std::ptrdiff_t>(block_first);
+      const auto last = first + static_cast<std::ptrdiff_t>(block_last);
+      for(; iterator != last; ++iterator){
+        f(*iterator);
+      }
+    });
+  }
+
+  /// parallel_for_each(f, x, y, z) は， parallel_for_each(apply(f), zip(x, y, z)) と等価．
+  template<class F, class... X>
+  requires(
+    sizeof...(X) >= 2 &&
+    (... && std::ranges::random_access_range<X>)
+  )
+  void parallel_for_each(F&& f, X&&... x)
+  {
+    ACCBOOST2::parallel_for_each(ACCBOOST2::Apply<F>(std::forward<F>(f)), ACCBOOST2::zip(std::forward<X>(x)...));
+  }
+
+  namespace _impl_parallel_for_each
+  {
+
+    /// args の最後の要素（ThreadPool）を除いたものを zip して parallel_for_each に渡す．
+    template<class F, class Tuple, std::size_t... I>
+    void zip_and_run(F&& f, Tuple&& args, std::index_sequence<I...>)
+    {
+      ACCBOOST2::parallel_for_each(ACCBOOST2::Apply<F>(std::forward<F>(f)), ACCBOOST2::zip(std::get<I>(std::move(args))...), std::get<sizeof...(I)>(args));
+    }
+
+  }
+
+  /// parallel_for_each(f, x, y, z, thread_pool) は， parallel_for_each(apply(f), zip(x, y, z), thread_pool) と等価．
+  template<class F, class... X>
+  requires(
+    sizeof...(X) >= 3 &&
+    std::is_same_v<std::tuple_element_t<sizeof...(X) - 1, std::tuple<X...>>, ThreadPool&>
+  )
+  void parallel_for_each(F&& f, X&&... x)
+  {
+    ACCBOOST2::_impl_parallel_for_each::zip_and_run(std::forward<F>(f), std::forward_as_tuple(std::forward<X>(x)...), std::make_index_sequence<sizeof...(X) - 1>());
+  }
+
+}
+
+
+#endif
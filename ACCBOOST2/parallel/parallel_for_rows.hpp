@@ -0,0 +1,85 @@
+#ifndef ACCBOOST2_PARALLEL_PARALLEL_FOR_ROWS_HPP_
+#define ACCBOOST2_PARALLEL_PARALLEL_FOR_ROWS_HPP_
+
+
+#include "../container/Array.hpp"
+#include "../container/Sparse2DArray.hpp"
+#include "ThreadPool.hpp"
+
+
+namespace ACCBOOST2
+{
+
+  namespace _impl_parallel_for_rows
+  {
+
+    /**
+     * 要素数（に 1 を加えたもの）の和がおおよそ等しくなるように size 本の行（列）をブロックに分割し，
+     * ブロックごとに thread_pool で並列に f(index, part(index)) を呼ぶ．
+     * ブロック数をスレッド数より多くし，偏りはワークスティーリングで均す．
+     */
+    template<class PartF, class F>
+    void parallel_for(std::size_t size, PartF&& part, F& f, ThreadPool& thread_pool)
+    {
+      if(size == 0) return;
+      std::size_t total_weight = 0;
+      for(std::size_t index = 0; index < size; ++index){
+        total_weight += part(index).size() + 1;
+      }
+      const std::size_t number_of_blocks = std::min(size, thread_pool.concurrency() * 8);
+      Array<std::size_t> boundaries;
+      boundaries.reserve(number_of_blocks + 1);
+      boundaries.push_back(0);
+      std::size_t weight = 0;
+      for(std::size_t index = 0; index < size; ++index){
+        weight += part(index).size() + 1;
+        if(boundaries.size() < number_of_blocks && weight * number_of_blocks >= total_weight * boundaries.size()){
+          boundaries.push_back(index + 1);
+        }
+      }
+      if(boundaries[boundaries.size() - 1] != size){
+        boundaries.push_back(size);
+      }
+      thread_pool.run(boundaries.size() - 1, [&](std::size_t block)
+      {
+        for(std::size_t index = boundaries[block]; index < boundaries[block + 1]; ++index){
+          f(index, part(index));
+        }
+      });
+    }
+
+  }
+
+  /**
+   * Sparse2DArray の全ての行について f(row_index, x.row(row_index)) を並列に呼ぶ．
+   * f は要素の値を書き換えてもよいが，要素の追加や削除をしてはならない．
+   */
+  template<class ValueType, class ListType, class IndexType, class F>
+  void parallel_for_rows(Sparse2DArray<ValueType, ListType, IndexType>& x, F&& f, ThreadPool& thread_pool = ThreadPool::global())
+  {
+    _impl_parallel_for_rows::parallel_for(x.row_size(), [&](std::size_t index){return x.row(index);}, f, thread_pool);
+  }
+
+  template<class ValueType, class ListType, class IndexType, class F>
+  void parallel_for_rows(const Sparse2DArray<ValueType, ListType, IndexType>& x, F&& f, ThreadPool& thread_pool = ThreadPool::global())
+  {
+    _impl_parallel_for_rows::parallel_for(x.row_size(), [&](std::size_t index){return x.row(index);}, f, thread_pool);
+  }
+
+  /// Sparse2DArray の全ての列について f(column_index, x.column(column_index)) を並列に呼ぶ．
+  template<class ValueType, class ListType, class IndexType, class F>
+  void parallel_for_columns(Sparse2DArray<ValueType, ListType, IndexType>& x, F&& f, ThreadPool& thread_pool = ThreadPool::global())
+  {
+    _impl_parallel_for_rows::parallel_for(x.column_size(), [&](std::size_t index){return x.column(index);}, f, thread_pool);
+  }
+
+  template<class ValueType, class ListType, class IndexType, class F>
+  void parallel_for_columns(const Sparse2DArray<ValueType, ListType, IndexType>& x, F&& f, ThreadPool& thread_pool = ThreadPool::global())
+  {
+    _impl_parallel_for_rows::parallel_for(x.column_size(), [&](std::size_t index){return x.column(index);}, f, thread_pool);
+  }
+
+}
+
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef ACCBOOST2_PARALLEL_PARALLEL_REDUCE_HPP_
+#define ACCBOOST2_PARALLEL_PARALLEL_REDUCE_HPP_
+
+
+#include <optional>
+#include "../utility.hpp"
+#include "../container/Array.hpp"
+#include "ThreadPool.hpp"
+
+
+namespace ACCBOOST2
+{
+
+  /**
+   * f で x の要素を畳み込んだ結果を initial_value に畳み込んで返す．
+   * ブロックごとに並列に畳み込んだ後，ブロックの結果を順に畳み込むので f は結合的であること（可換である必要はない）．
+   * ブロックの結果どうしも f で畳み込むので，x の要素の型は initial_value の型と同じであること（異なる場合は combine を取る版を使う）．
+   */
+  template<class F, class ValueType, class X>
+  requires(
+    std::ranges::random_access_range<X> &&
+    std::sized_sentinel_for<std::ranges::sentinel_t<X>, std::ranges::iterator_t<X>> &&
+    std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<X>>, std::remove_cvref_t<ValueType>> &&
+    std::invocable<F&, std::remove_cvref_t<ValueType>, std::remove_cvref_t<ValueType>>
+  )
+  std::remove_cv_t<std::remove_reference_t<ValueType>> parallel_reduce(F&& f, ValueType&& initial_value, X&& x, ThreadPool& thread_pool = ThreadPool::global())
+  {
+    using std::begin;
+    using std::end;
+    using value_type = std::remove_cv_t<std::remove_reference_t<ValueType>>;
+    const auto first = begin(x);
+    const std::ptrdiff_t n = end(x) - first;
+    value_type result(std::forward<ValueType>(initial_value));
+    if(n <= 0) return result;
+    // ブロックごとの結果（ブロックは run_blocks と同じ規則で分割される）
+    const std::size_t number_of_blocks = std::min(static_cast<std::size_t>(n), thread_pool.concurrency() * 8);
+    Array<std::optional<value_type>> partial_results(number_of_blocks);
+    thread_pool.run(number_of_blocks, [&](std::size_t block)
+    {
+      auto iterator = first + static_cast<std::ptrdiff_t>(block * n / number_of_blocks);
+      const auto last = first + static_cast<std::ptrdiff_t>((block + 1) * n / number_of_blocks);
+      assert(iterator != last);
+      value_type partial_result(*iterator);
+      for(++iterator; iterator != last; ++iterator){
+        partial_result = f(std::move(partial_result), *iterator);
+      }
+      partial_results[block].emplace(std::move(partial_result));
+    });
+    for(auto&& partial_result: partial_results){
+      assert(partial_result.has_value());
+      result = f(std::move(result), std::move(*partial_result));
+    }
+    return result;
+  }
+
+  /**
+   * f(accumulator, element) で x の要素を畳み込み，ブロックの結果を combine(accumulator, accumulator) で initial_value に順に畳み込んで返す．
+   * 各ブロックは value_type() から畳み込むので，value_type() は combine の単位元であること．
+   * 畳み込みの型と要素の型が異なる場合（要素の数え上げなど）に使う．
+   */
+  template<class F, class CombineF, class ValueType, class X>
+  requires(
+    std::ranges::random_access_range<X> &&
+    std::sized_sentinel_for<std::ranges::sentinel_t<X>, std::ranges::iterator_t<X>> &&
+    std::default_initializable<std::remove_cvref_t<ValueType>> &&
+    std::invocable<F&, std::remove_cvref_t<ValueType>, std::ranges::range_reference_t<X>> &&
+    std::invocable<CombineF&, std::remove_cvref_t<ValueType>, std::remove_cvref_t<ValueType>>
+  )
+  std::remove_cv_t<std::remove_reference_t<ValueType>> parallel_reduce(F&& f, CombineF&& combine, ValueType&& initial_value, X&& x, ThreadPool& thread_pool = ThreadPool::global())
+  {
+    using std::begin;
+    using std::end;
+    using value_type = std::remove_cv_t<std::remove_reference_t<ValueType>>;
+    const auto first = begin(x);
+    const std::ptrdiff_t n = end(x) - first;
+    value_type result(std::forward<ValueType>(initial_value));
+    if(n <= 0) return result;
+    const std::size_t number_of_blocks = std::min(static_cast<std::size_t>(n), thread_pool.concurrency() * 8);
+    Array<std::optional<value_type>> partial_results(number_of_blocks);
+    thread_pool.run(number_of_blocks, [&](std::size_t block)
+    {
+      auto iterator = first + static_cast<std::ptrdiff_t>(block * n / number_of_blocks);
+      const auto last = first + static_cast<std::ptrdiff_t>((block + 1) * n / number_of_blocks);
+      value_type partial_result{};
+      for(; iterator != last; ++iterator){
+        partial_result = f(std::move(partial_result), *iterator);
+      }
+      partial_results[block].emplace(std::move(partial_result));
+    });
+    for(auto&& partial_result: partial_results){
+      assert(partial_result.has_value());
+      result = combine(std::move(result), std::move(*partial_result));
+    }
+    return result;
+  }
+
+}
+
+
+#endif
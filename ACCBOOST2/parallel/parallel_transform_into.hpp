@@ -0,0 +1,46 @@
+#ifndef ACCBOOST2_PARALLEL_PARALLEL_TRANSFORM_INTO_HPP_
+#define ACCBOOST2_PARALLEL_PARALLEL_TRANSFORM_INTO_HPP_
+
+
+#include "../utility.hpp"
+#include "ThreadPool.hpp"
+
+
+namespace ACCBOOST2
+{
+
+  /**
+   * x の i 番目の要素を out の i 番目の要素に並列に代入する．
+   * out は x 以上の長さを持つランダムアクセス可能な範囲であること（要素の追加はしない）．
+   * parallel_transform_into(out, map(f, range(n))) のように map と組み合わせて使う．
+   */
+  template<class Y, class X>
+  requires(
+    std::ranges::random_access_range<Y> &&
+    std::ranges::random_access_range<X> &&
+    std::sized_sentinel_for<std::ranges::sentinel_t<X>, std::ranges::iterator_t<X>>
+  )
+  void parallel_transform_into(Y&& out, X&& x, ThreadPool& thread_pool = ThreadPool::global())
+  {
+    using std::begin;
+    using std::end;
+    const auto first = begin(x);
+    const std::ptrdiff_t n = end(x) - first;
+    const auto out_first = begin(out);
+    assert(end(out) - out_first >= n);
+    if(n <= 0) return;
+    thread_pool.run_blocks(static_cast<std::size_t>(n), [&](std::size_t block_first, std::size_t block_last)
+    {
+      auto iterator = first + static_cast<std::ptrdiff_t>(block_first);
+      const auto last = first + static_cast<std::ptrdiff_t>(block_last);
+      auto out_iterator = out_first + static_cast<std::ptrdiff_t>(block_first);
+      for(; iterator != last; ++iterator, ++out_iterator){
+        *out_iterator = *iterator;
+      }
+    });
+  }
+
+}
+
+
+#endif
@@ -3,6 +3,7 @@
 
 
 #include "../misc.hpp"
+#include "../iterator/make_integer_iterator.hpp"
 
 
 namespace ACCBOOST2
@@ -12,20 +13,76 @@ namespace ACCBOOST2
   {
 
     template<std::size_t... I>
-    decltype(auto) impl(std::index_sequence<I...>)
+    constexpr decltype(auto) impl(std::index_sequence<I...>) noexcept
     {
       return std::array<std::size_t, sizeof...(I)>{I...};
     }
 
+    template<class F, std::size_t... I>
+    ACCBOOST2_INLINE constexpr void static_for(F& f, std::index_sequence<I...>)
+    {
+      (f(std::integral_constant<std::size_t, I>()), ...);
+    }
+
+    /// 要素数がコンパイル時に決まる整数の範囲 [0, N)．
+    template<std::size_t N>
+    class StaticRange
+    {
+    public:
+
+      static constexpr std::size_t size() noexcept
+      {
+        return N;
+      }
+
+      constexpr std::size_t operator[](std::size_t i) const noexcept
+      {
+        assert(i < N);
+        return i;
+      }
+
+      constexpr decltype(auto) begin() const noexcept
+      {
+        return ACCBOOST2::make_integer_iterator(std::size_t(0));
+      }
+
+      constexpr decltype(auto) end() const noexcept
+      {
+        return ACCBOOST2::make_integer_iterator(N);
+      }
+
+    };
+
   }
 
   /// range<N>() は [0, 1, ..., N] を返す．
   template<std::size_t N>
-  decltype(auto) range() noexcept
+  constexpr decltype(auto) range() noexcept
   {
     return ACCBOOST2::_utility_array_range::impl(std::make_index_sequence<N>());
   }
 
+  /**
+   * static_range<N>() は [0, N) を表す範囲を返す．
+   * 要素を持たず，ループの回数がコンパイル時に決まるので，小さな N ではコンパイラがループを展開できる．
+   */
+  template<std::size_t N>
+  constexpr decltype(auto) static_range() noexcept
+  {
+    return ACCBOOST2::_utility_array_range::StaticRange<N>();
+  }
+
+  /**
+   * f(std::integral_constant<std::size_t, 0>()), ..., f(std::integral_constant<std::size_t, N - 1>()) を順に呼ぶ．
+   * ループの展開が保証され，添字を std::get などのテンプレート引数にも使える．
+   */
+  template<std::size_t N, class F>
+  constexpr ACCBOOST2::capture_of<F&&> static_for(F&& f)
+  {
+    ACCBOOST2::_utility_array_range::static_for(f, std::make_index_sequence<N>());
+    return std::forward<F>(f);
+  }
+
 }
 
 
@@ -4,7 +4,9 @@
 
 #include "iterable/chain.hpp"
 #include "iterable/chain_from_iterable.hpp"
+#include "iterable/chunks.hpp"
 #include "iterable/filter.hpp"
+#include "iterable/for_each.hpp"
 #include "iterable/map.hpp"
 #include "iterable/range.hpp"
 #include "iterable/reverse.hpp"
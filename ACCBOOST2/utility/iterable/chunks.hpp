@@ -0,0 +1,175 @@
+#ifndef ACCBOOST2_UTILITY_ITERABLE_CHUNKS_HPP_
+#define ACCBOOST2_UTILITY_ITERABLE_CHUNKS_HPP_
+
+
+#include <algorithm>
+#include <span>
+#include "../misc.hpp"
+#include "../iterator.hpp"
+
+
+namespace ACCBOOST2
+{
+
+  namespace _utility_iterable_chunks
+  {
+
+    template<class X>
+    using element_t = std::remove_reference_t<std::ranges::range_reference_t<X>>;
+
+    template<class X>
+    concept contiguous_sized_lvalue = std::is_lvalue_reference_v<X> && std::ranges::contiguous_range<X> && std::ranges::sized_range<X>;
+
+    /// 先頭ポインタの組から，offset から始まる長さ n のブロックを作る．
+    template<std::size_t Extent, class... T>
+    decltype(auto) make_chunk(const std::tuple<T*...>& data, std::size_t offset, std::size_t n) noexcept
+    {
+      return ACCBOOST2::apply([&](T*... p)
+      {
+        if constexpr (sizeof...(T) == 1){
+          return std::span<T..., Extent>(p + offset..., n);
+        }else{
+          return std::tuple<std::span<T, Extent>...>(std::span<T, Extent>(p + offset, n)...);
+        }
+      }, data);
+    }
+
+    /// ブロックの番号からブロックを作るファンクタ．
+    template<std::size_t Extent, class... T>
+    class ChunkFunctor
+    {
+    private:
+
+      std::tuple<T*...> _data;
+      std::size_t _block_size;
+      std::size_t _size;
+
+    public:
+
+      ChunkFunctor(const std::tuple<T*...>& data, std::size_t block_size, std::size_t size) noexcept:
+        _data(data), _block_size(block_size), _size(size)
+      {}
+
+      ChunkFunctor() = default;
+      ChunkFunctor(ChunkFunctor&&) = default;
+      ChunkFunctor(const ChunkFunctor&) = default;
+      ChunkFunctor& operator=(ChunkFunctor&&) = default;
+      ChunkFunctor& operator=(const ChunkFunctor&) = default;
+
+      decltype(auto) operator()(std::size_t k) const noexcept
+      {
+        const std::size_t offset = k * _block_size;
+        if constexpr (Extent == std::dynamic_extent){
+          return make_chunk<Extent>(_data, offset, std::min(_block_size, _size - offset));
+        }else{
+          return make_chunk<Extent>(_data, offset, Extent);
+        }
+      }
+
+    };
+
+    template<std::size_t Extent, class... T>
+    class ChunkedRange
+    {
+    private:
+
+      std::tuple<T*...> _data;
+      std::size_t _block_size;
+      std::size_t _size;
+      std::size_t _number_of_blocks;
+      ChunkFunctor<Extent, T...> _functor;
+
+    public:
+
+      ChunkedRange(const std::tuple<T*...>& data, std::size_t block_size, std::size_t size) noexcept:
+        _data(data), _block_size(block_size), _size(size),
+        _number_of_blocks(Extent == std::dynamic_extent ? (size + block_size - 1) / block_size : size / block_size),
+        _functor(data, block_size, size)
+      {
+        assert(block_size > 0);
+      }
+
+      ChunkedRange() = default;
+      ChunkedRange(ChunkedRange&&) = default;
+      ChunkedRange(const ChunkedRange&) = default;
+      ChunkedRange& operator=(ChunkedRange&&) = default;
+      ChunkedRange& operator=(const ChunkedRange&) = default;
+
+      /// ブロックの数
+      std::size_t size() const noexcept
+      {
+        return _number_of_blocks;
+      }
+
+      decltype(auto) operator[](std::size_t k) const noexcept
+      {
+        assert(k < _number_of_blocks);
+        return _functor(k);
+      }
+
+      decltype(auto) begin() const
+      {
+        return ACCBOOST2::make_map_iterator(_functor, ACCBOOST2::make_integer_iterator(std::size_t(0)));
+      }
+
+      decltype(auto) end() const
+      {
+        return ACCBOOST2::make_map_iterator(_functor, ACCBOOST2::make_integer_iterator(_number_of_blocks));
+      }
+
+      /// ブロックに含まれなかった末尾の要素（blocked の場合は常に空）．
+      decltype(auto) remainder() const noexcept
+      {
+        const std::size_t offset = _number_of_blocks * _block_size;
+        return make_chunk<std::dynamic_extent>(_data, std::min(offset, _size), _size - std::min(offset, _size));
+      }
+
+    };
+
+    template<std::size_t Extent, class... X>
+    decltype(auto) make_chunked_range(std::size_t block_size, X&&... x)
+    {
+      const std::size_t size = std::min<std::size_t>({static_cast<std::size_t>(std::ranges::size(x))...});
+      return ChunkedRange<Extent, element_t<X>...>(std::tuple<element_t<X>*...>(std::ranges::data(x)...), block_size, size);
+    }
+
+  }
+
+
+  /**
+   * 連続した領域を持つ範囲 x, ... を長さ N のブロックに分割する．
+   * 各ブロックは std::span<T, N>（複数の範囲を与えた場合はその std::tuple）で，長さがコンパイル時に決まるので，
+   * ブロック内のループは要素ごとの zip よりもベクトル化されやすい．
+   * N で割り切れない末尾の要素は remainder() で得られる．
+   */
+  template<std::size_t N, class... X>
+  requires(
+    N > 0 &&
+    sizeof...(X) >= 1 &&
+    (... && _utility_iterable_chunks::contiguous_sized_lvalue<X&&>)
+  )
+  decltype(auto) chunks(X&&... x)
+  {
+    return _utility_iterable_chunks::make_chunked_range<N>(N, std::forward<X>(x)...);
+  }
+
+
+  /**
+   * 連続した領域を持つ範囲 x, ... を長さ n のブロックに分割する．
+   * 各ブロックは std::span<T>（複数の範囲を与えた場合はその std::tuple）で，最後のブロックのみ n より短い場合がある．
+   */
+  template<class... X>
+  requires(
+    sizeof...(X) >= 1 &&
+    (... && _utility_iterable_chunks::contiguous_sized_lvalue<X&&>)
+  )
+  decltype(auto) blocked(std::size_t n, X&&... x)
+  {
+    return _utility_iterable_chunks::make_chunked_range<std::dynamic_extent>(n, std::forward<X>(x)...);
+  }
+
+
+}
+
+
+#endif
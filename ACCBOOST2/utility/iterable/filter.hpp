@@ -39,6 +39,18 @@ namespace ACCBOOST2
       FilteredRange& operator=(FilteredRange&&) = default;
       FilteredRange& operator=(const FilteredRange&) = default;
 
+      /// 要素に適用するファンクタ（for_each などの内部イテレーションで使う）．
+      const FunctorType& functor() const noexcept
+      {
+        return functor_;
+      }
+
+      /// 元の範囲（for_each などの内部イテレーションで使う）．
+      const RangeType& range() const noexcept
+      {
+        return range_;
+      }
+
       decltype(auto) begin() const
       {
         using std::begin;
@@ -0,0 +1,112 @@
+#ifndef ACCBOOST2_UTILITY_ITERABLE_FOR_EACH_HPP_
+#define ACCBOOST2_UTILITY_ITERABLE_FOR_EACH_HPP_
+
+
+#include "../misc.hpp"
+#include "filter.hpp"
+#include "map.hpp"
+
+
+namespace ACCBOOST2
+{
+
+  namespace _utility_iterable_for_each
+  {
+
+    template<class X>
+    constexpr bool is_mapped_range = ACCBOOST2::META::is_template_of_v<ACCBOOST2::_utility_iterable_map::MappedRange, std::remove_cvref_t<X>>;
+
+    template<class X>
+    constexpr bool is_filtered_range = ACCBOOST2::META::is_template_of_v<ACCBOOST2::_utility_iterable_filter::FilteredRange, std::remove_cvref_t<X>>;
+
+    /**
+     * x の要素を順に f に渡す．
+     * map と filter は外側から剥がしてファンクタに合成し，最も内側の範囲だけをループで回す．
+     * これにより，入れ子になったイテレータの進行や番兵との比較を要素ごとに行わずに済む．
+     */
+    template<class F, class X>
+    inline ACCBOOST2_INLINE void push(F&& f, X&& x)
+    {
+      if constexpr (is_mapped_range<X>){
+        const auto& g = x.functor();
+        ACCBOOST2::_utility_iterable_for_each::push([&f, &g](auto&& y) ACCBOOST2_INLINE
+        {
+          f(g(std::forward<decltype(y)>(y)));
+        }, x.range());
+      }else if constexpr (is_filtered_range<X>){
+        const auto& g = x.functor();
+        ACCBOOST2::_utility_iterable_for_each::push([&f, &g](auto&& y) ACCBOOST2_INLINE
+        {
+          if(g(y)){
+            f(std::forward<decltype(y)>(y));
+          }
+        }, x.range());
+      }else if constexpr (std::ranges::random_access_range<X> && std::ranges::sized_range<X>){
+        // note: 添字によるループにすると，コンパイラがループの回数を把握しやすい．
+        using std::begin;
+        auto first = begin(x);
+        const std::size_t n = static_cast<std::size_t>(std::ranges::size(x));
+        for(std::size_t i = 0; i < n; ++i){
+          f(first[i]);
+        }
+      }else{
+        for(auto&& y: x){
+          f(std::forward<decltype(y)>(y));
+        }
+      }
+    }
+
+  }
+
+
+  /**
+   * x の全ての要素に f を適用する．
+   * map や filter を組み合わせた範囲は，イテレータを介さずに 1 つのループとして実行する．
+   */
+  template<class F, class X>
+  requires(
+    std::ranges::range<std::remove_reference_t<X>>
+  )
+  ACCBOOST2::capture_of<F&&> for_each(F&& f, X&& x)
+  {
+    ACCBOOST2::_utility_iterable_for_each::push(f, x);
+    return std::forward<F>(f);
+  }
+
+
+  /// initial_value から始めて，x の要素を先頭から順に f で畳み込む．
+  template<class F, class ValueType, class X>
+  requires(
+    std::ranges::range<std::remove_reference_t<X>>
+  )
+  std::remove_cvref_t<ValueType> reduce(F&& f, ValueType&& initial_value, X&& x)
+  {
+    std::remove_cvref_t<ValueType> result(std::forward<ValueType>(initial_value));
+    ACCBOOST2::_utility_iterable_for_each::push([&f, &result](auto&& y) ACCBOOST2_INLINE
+    {
+      result = f(std::move(result), std::forward<decltype(y)>(y));
+    }, x);
+    return result;
+  }
+
+
+  /// x の要素数を数える（filter を組み合わせた範囲では条件を満たす要素数になる）．
+  template<class X>
+  requires(
+    std::ranges::range<std::remove_reference_t<X>>
+  )
+  std::size_t count(X&& x)
+  {
+    std::size_t result = 0;
+    ACCBOOST2::_utility_iterable_for_each::push([&result](auto&&) ACCBOOST2_INLINE
+    {
+      ++result;
+    }, x);
+    return result;
+  }
+
+
+}
+
+
+#endif
@@ -39,6 +39,27 @@ namespace ACCBOOST2
       MappedRange& operator=(MappedRange&&) = default;
       MappedRange& operator=(const MappedRange&) = default;
 
+      /// 要素に適用するファンクタ（for_each などの内部イテレーションで使う）．
+      const FunctorType& functor() const noexcept
+      {
+        return functor_;
+      }
+
+      /// 元の範囲（for_each などの内部イテレーションで使う）．
+      const RangeType& range() const noexcept
+      {
+        return range_;
+      }
+
+      template<class R = std::remove_reference_t<RangeType>>
+      requires(
+        std::ranges::sized_range<const R>
+      )
+      decltype(auto) size() const
+      {
+        return std::ranges::size(range_);
+      }
+
       decltype(auto) begin() const
       {
         using std::begin;
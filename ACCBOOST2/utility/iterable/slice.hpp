@@ -30,6 +30,27 @@ public:
     _first(first), _last(last), _range(std::forward<RangeType>(range))
   {}
 
+  std::size_t size() const noexcept
+  {
+    assert(_first <= _last);
+    return static_cast<std::size_t>(_last - _first);
+  }
+
+  template<class R = std::remove_reference_t<RangeType>>
+  requires(
+    std::ranges::contiguous_range<R>
+  )
+  decltype(auto) data() const noexcept
+  {
+    return std::ranges::data(_range) + _first;
+  }
+
+  decltype(auto) operator[](std::size_t i) const noexcept
+  {
+    assert(i < size());
+    return _range.begin()[_first + i];
+  }
+
   decltype(auto) begin() const noexcept
   {
     return _range.begin() + _first;
@@ -42,6 +42,32 @@ namespace ACCBOOST2
 
       ZippedRange& operator=(const ZippedRange&) = default;
 
+      /// 全ての範囲の長さが求まる場合は，最も短い範囲の長さを返す．
+      std::size_t size() const requires((... && std::ranges::sized_range<const std::remove_reference_t<RangesT>>))
+      {
+        return ACCBOOST2::apply([](const auto&... r)
+        {
+          return std::min<std::size_t>({static_cast<std::size_t>(std::ranges::size(r))...});
+        }, ranges_);
+      }
+
+      /// 全ての範囲が連続した領域を持つ場合は，それぞれの先頭へのポインタの組を返す．
+      decltype(auto) data() const requires((... && std::ranges::contiguous_range<const std::remove_reference_t<RangesT>>))
+      {
+        return ACCBOOST2::apply([](const auto&... r)
+        {
+          return std::make_tuple(std::ranges::data(r)...);
+        }, ranges_);
+      }
+
+      decltype(auto) data() requires((... && std::ranges::contiguous_range<std::remove_reference_t<RangesT>>))
+      {
+        return ACCBOOST2::apply([](auto&... r)
+        {
+          return std::make_tuple(std::ranges::data(r)...);
+        }, ranges_);
+      }
+
       decltype(auto) begin() const
       {
         using std::begin;
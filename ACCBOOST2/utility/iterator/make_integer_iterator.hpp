@@ -40,60 +40,60 @@ namespace ACCBOOST2
       IntegerIterator() = default;
       IntegerIterator(IntegerIterator&&) = default;
       IntegerIterator(const IntegerIterator&) = default;
-      IntegerIterator& operator=(IntegerIterator&&) = default;
-      IntegerIterator& operator=(const IntegerIterator&) = default;
+      constexpr IntegerIterator& operator=(IntegerIterator&&) = default;
+      constexpr IntegerIterator& operator=(const IntegerIterator&) = default;
 
-      explicit IntegerIterator(IntegerType&& integer) noexcept(std::is_nothrow_move_constructible_v<IntegerType>):
+      constexpr explicit IntegerIterator(IntegerType&& integer) noexcept(std::is_nothrow_move_constructible_v<IntegerType>):
         _integer(std::move(integer))
       {}
 
-      explicit IntegerIterator(const IntegerType& integer) noexcept(std::is_nothrow_copy_constructible_v<IntegerType>):
+      constexpr explicit IntegerIterator(const IntegerType& integer) noexcept(std::is_nothrow_copy_constructible_v<IntegerType>):
         _integer(integer)
       {}
 
       template<class I>
-      bool operator==(const IntegerIterator<I>& other) const noexcept
+      constexpr bool operator==(const IntegerIterator<I>& other) const noexcept
       {
         return _integer == other._integer;
       }
 
       template<class I>
-      bool operator!=(const IntegerIterator<I>& other) const noexcept
+      constexpr bool operator!=(const IntegerIterator<I>& other) const noexcept
       {
         return _integer != other._integer;
       }
 
       template<class I>
-      bool operator<(const IntegerIterator<I>& other) const noexcept
+      constexpr bool operator<(const IntegerIterator<I>& other) const noexcept
       {
         return _integer < other._integer;
       }
 
       template<class I>
-      bool operator>(const IntegerIterator<I>& other) const noexcept
+      constexpr bool operator>(const IntegerIterator<I>& other) const noexcept
       {
         return _integer > other._integer;
       }
 
       template<class I>
-      bool operator<=(const IntegerIterator<I>& other) const noexcept
+      constexpr bool operator<=(const IntegerIterator<I>& other) const noexcept
       {
         return _integer <= other._integer;
       }
 
       template<class I>
-      bool operator>=(const IntegerIterator<I>& other) const noexcept
+      constexpr bool operator>=(const IntegerIterator<I>& other) const noexcept
       {
         return _integer >= other._integer;
       }
 
       template<class I>
-      difference_type operator-(const IntegerIterator<I>& other) const noexcept
+      constexpr difference_type operator-(const IntegerIterator<I>& other) const noexcept
       {
         return static_cast<difference_type>(_integer) - static_cast<difference_type>(other._integer);
       }
 
-      reference operator*() const noexcept
+      constexpr reference operator*() const noexcept
       {
         return _integer;
       }
@@ -103,50 +103,50 @@ namespace ACCBOOST2
         return ACCBOOST2::make_arrow_wrapper(operator*());
       }
 
-      reference operator[](difference_type d) const noexcept
+      constexpr reference operator[](difference_type d) const noexcept
       {
         return _integer + d;
       }
 
-      IntegerIterator operator+(difference_type d) const noexcept
+      constexpr IntegerIterator operator+(difference_type d) const noexcept
       {
         return IntegerIterator(_integer + d);
       }
 
-      IntegerIterator operator-(difference_type d) const noexcept
+      constexpr IntegerIterator operator-(difference_type d) const noexcept
       {
         return IntegerIterator(_integer - d);
       }
 
-      IntegerIterator& operator++() noexcept
+      constexpr IntegerIterator& operator++() noexcept
       {
         ++_integer;
         return *this;
       }
 
-      IntegerIterator& operator--() noexcept
+      constexpr IntegerIterator& operator--() noexcept
       {
         --_integer;
         return *this;
       }
 
-      IntegerIterator operator++(int) noexcept
+      constexpr IntegerIterator operator++(int) noexcept
       {
-        return _integer++;
+        return IntegerIterator(_integer++);
       }
 
-      IntegerIterator operator--(int) noexcept
+      constexpr IntegerIterator operator--(int) noexcept
       {
-        return _integer--;        
+        return IntegerIterator(_integer--);
       }
 
-      IntegerIterator& operator+=(difference_type d) noexcept
+      constexpr IntegerIterator& operator+=(difference_type d) noexcept
       {
         _integer += d;
         return *this;
       }
 
-      IntegerIterator& operator-=(difference_type d) noexcept
+      constexpr IntegerIterator& operator-=(difference_type d) noexcept
       {
         _integer -= d;
         return *this;
@@ -155,7 +155,7 @@ namespace ACCBOOST2
     };
 
     template<class IntegerType>
-    IntegerIterator<IntegerType> operator+(typename IntegerIterator<IntegerType>::difference_type d, const IntegerIterator<IntegerType>& iterator) noexcept
+    constexpr IntegerIterator<IntegerType> operator+(typename IntegerIterator<IntegerType>::difference_type d, const IntegerIterator<IntegerType>& iterator) noexcept
     {
       return iterator + d;
     }
@@ -165,7 +165,7 @@ namespace ACCBOOST2
 
 
   template<class IntegerType>
-  decltype(auto) make_integer_iterator(IntegerType&& integer) noexcept
+  constexpr decltype(auto) make_integer_iterator(IntegerType&& integer) noexcept
   {
     return ACCBOOST2::_utility_iterator_make_integer_iterator::IntegerIterator<
       std::remove_const_t<std::remove_reference_t<IntegerType>>
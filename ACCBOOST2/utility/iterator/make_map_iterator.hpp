@@ -144,12 +144,16 @@ namespace ACCBOOST2
 
       MapIterator operator+(difference_type d) const requires(std::random_access_iterator<IteratorType>)
       {
-        return MapIterator(functor_, iterator_ + d);
+        MapIterator tmp(*this);
+        tmp.iterator_ += d;
+        return tmp;
       }
 
       MapIterator operator-(difference_type d) const requires(std::random_access_iterator<IteratorType>)
       {
-        return MapIterator(functor_, iterator_ - d);        
+        MapIterator tmp(*this);
+        tmp.iterator_ -= d;
+        return tmp;
       }
 
       MapIterator& operator++()
@@ -166,12 +170,16 @@ namespace ACCBOOST2
 
       MapIterator operator++(int)
       {
-        return MapIterator(functor_, iterator_++);
+        MapIterator tmp(*this);
+        ++iterator_;
+        return tmp;
       }
 
       MapIterator operator--(int) requires(std::bidirectional_iterator<IteratorType>)
       {
-        return MapIterator(functor_, iterator_--);
+        MapIterator tmp(*this);
+        --iterator_;
+        return tmp;
       }
 
       MapIterator& operator+=(difference_type d) requires(std::random_access_iterator<IteratorType>)
@@ -0,0 +1,55 @@
+#ifndef BENCHUTILS_HPP_
+#define BENCHUTILS_HPP_
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <string>
+
+
+namespace BENCH_UTILS
+{
+
+  /// x を計算した結果が使われたものとしてコンパイラに扱わせ，最適化で計算が消えるのを防ぐ．
+  template<class T>
+  static inline void do_not_optimize(const T& x)
+  {
+    asm volatile("" : : "r,m"(x) : "memory");
+  }
+
+  /**
+   * 計測結果を「ベンチマーク名<TAB>指標<TAB>値」の 1 行で出力する．
+   * 指標は全て小さいほど良いものとし，compare.awk で基準値と比較する．
+   */
+  static inline void report(const std::string& name, const std::string& metric, double value)
+  {
+    std::cout << name << "\t" << metric << "\t" << value << std::endl;
+  }
+
+  /**
+   * f() を repeat 回実行し，最も速かった回の 1 項目あたりの時間 [ns] を出力する．
+   * 最短時間を使うのは，他のプロセスの割り込みなどによる揺らぎを除くため．
+   */
+  template<class F>
+  static inline double measure(const std::string& name, std::size_t items, F&& f, std::size_t repeat = 5)
+  {
+    using clock = std::chrono::steady_clock;
+    double best = std::numeric_limits<double>::infinity();
+    for(std::size_t r = 0; r < repeat; ++r){
+      auto t0 = clock::now();
+      f();
+      auto t1 = clock::now();
+      best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    double ns_per_item = best * 1e9 / static_cast<double>(items);
+    report(name, "ns/item", ns_per_item);
+    return ns_per_item;
+  }
+
+}
+
+
+#endif
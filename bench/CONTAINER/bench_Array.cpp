@@ -0,0 +1,38 @@
+#include "Array.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  constexpr std::size_t size = 1 << 20;
+
+  BENCH_UTILS::measure("Array/push_back", size, [&]()
+  {
+    Array<double> a;
+    for(std::size_t i = 0; i < size; ++i){
+      a.push_back(static_cast<double>(i));
+    }
+    BENCH_UTILS::do_not_optimize(a[size - 1]);
+  });
+
+  Array<double> source(size, 1.0);
+
+  BENCH_UTILS::measure("Array/expand_contiguous", size, [&]()
+  {
+    Array<double> a;
+    a.expand(source);
+    BENCH_UTILS::do_not_optimize(a[size - 1]);
+  });
+
+  BENCH_UTILS::measure("Array/expand_map", size, [&]()
+  {
+    Array<double> a;
+    a.expand(map([](double x){return x * 2;}, source));
+    BENCH_UTILS::do_not_optimize(a[size - 1]);
+  });
+
+  return 0;
+}
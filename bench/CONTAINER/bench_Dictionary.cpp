@@ -0,0 +1,59 @@
+#include "Dictionary.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  constexpr std::size_t size = 1 << 18;
+
+  auto key = [](std::size_t i){return static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ull;};
+
+  BENCH_UTILS::measure("Dictionary/add", size, [&]()
+  {
+    Dictionary<std::uint64_t, double> d;
+    for(std::size_t i = 0; i < size; ++i){
+      d.add(key(i), 1.0);
+    }
+    BENCH_UTILS::do_not_optimize(d.size());
+  });
+
+  Dictionary<std::uint64_t, double> d;
+  for(std::size_t i = 0; i < size; ++i){
+    d.add(key(i), 1.0);
+  }
+
+  BENCH_UTILS::measure("Dictionary/lookup", size, [&]()
+  {
+    double sum = 0;
+    for(std::size_t i = 0; i < size; ++i){
+      sum += d[key(i)];
+    }
+    BENCH_UTILS::do_not_optimize(sum);
+  });
+
+  BENCH_UTILS::measure("Dictionary/lookup_missing", size, [&]()
+  {
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < size; ++i){
+      n += d.contain(key(i + size));
+    }
+    BENCH_UTILS::do_not_optimize(n);
+  });
+
+  BENCH_UTILS::measure("Dictionary/add_erase", size, [&]()
+  {
+    Dictionary<std::uint64_t, double> e;
+    for(std::size_t i = 0; i < size; ++i){
+      e.add(key(i), 1.0);
+    }
+    for(std::size_t i = 0; i < size; ++i){
+      e.erase(key(i));
+    }
+    BENCH_UTILS::do_not_optimize(e.size());
+  }, 3);
+
+  return 0;
+}
@@ -0,0 +1,39 @@
+#include <cstdlib>
+#include "Array.hpp"
+#include "MEMORY/PoolAllocator.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+/// 生存中のブロックを一定数に保ちながら確保と解放を繰り返す．
+template<class Allocate, class Deallocate>
+void churn(const char* name, std::size_t live, std::size_t steps, Allocate&& allocate, Deallocate&& deallocate)
+{
+  Array<void*> pointers(live, nullptr);
+  BENCH_UTILS::measure(name, steps, [&]()
+  {
+    for(auto& p: pointers) p = allocate();
+    std::size_t k = 0;
+    for(std::size_t i = 0; i < steps; ++i){
+      k = (k * 1103515245 + 12345) % live;
+      deallocate(pointers[k]);
+      pointers[k] = allocate();
+    }
+    for(auto& p: pointers) deallocate(p);
+  });
+}
+
+
+int main()
+{
+  constexpr std::size_t live = 1 << 14;
+  constexpr std::size_t steps = 1 << 22;
+
+  MEMORY::PoolAllocator<48, 8> allocator;
+  churn("PoolAllocator/churn", live, steps, [&](){return allocator.allocate();}, [&](void* p){allocator.deallocate(p);});
+  churn("PoolAllocator/malloc_baseline", live, steps, [](){return std::malloc(48);}, [](void* p){std::free(p);});
+
+  return 0;
+}
@@ -0,0 +1,72 @@
+#include <malloc.h>
+
+#include "Sparse2DArray.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+/// malloc で確保中のバイト数（mmap による確保を含む）
+static std::size_t allocated_bytes()
+{
+  auto info = ::mallinfo2();
+  return info.uordblks + info.hblkhd;
+}
+
+
+/// Sparse2DArray のノード構成・番号の型ごとに，非ゼロ要素あたりのメモリ使用量と各操作の時間を計測する．
+template<class Sparse2DArrayType>
+void run(const std::string& name, std::size_t size, std::size_t nonzeros_per_row)
+{
+  const std::size_t nonzeros = size * nonzeros_per_row;
+  auto column = [&](std::size_t i, std::size_t k){return (i * 7919 + k * 104729) % size;};
+
+  std::size_t bytes_before = allocated_bytes();
+  Sparse2DArrayType a(size, size);
+  BENCH_UTILS::measure(name + "/emplace", nonzeros, [&]()
+  {
+    a.clear();
+    for(std::size_t i = 0; i < size; ++i){
+      for(std::size_t k = 0; k < nonzeros_per_row; ++k){
+        a.emplace(i, column(i, k), 1.0);
+      }
+    }
+  }, 3);
+  BENCH_UTILS::report(name, "bytes/nonzero", static_cast<double>(allocated_bytes() - bytes_before) / static_cast<double>(nonzeros));
+
+  BENCH_UTILS::measure(name + "/get", nonzeros, [&]()
+  {
+    double sum = 0;
+    for(std::size_t i = 0; i < size; ++i){
+      for(std::size_t k = 0; k < nonzeros_per_row; ++k){
+        sum += a.get(i, column(i, k));
+      }
+    }
+    BENCH_UTILS::do_not_optimize(sum);
+  }, 3);
+
+  BENCH_UTILS::measure(name + "/row_iteration", nonzeros, [&]()
+  {
+    double sum = 0;
+    for(std::size_t i = 0; i < size; ++i){
+      for(auto&& [row_index, column_index, value]: a.row(i)){
+        sum += value;
+      }
+    }
+    BENCH_UTILS::do_not_optimize(sum);
+  });
+}
+
+
+int main()
+{
+  using namespace ACCBOOST2;
+
+  constexpr std::size_t size = 100000;
+  constexpr std::size_t nonzeros_per_row = 10;
+
+  run<Sparse2DArray<double, SPARSE_ASSEMBLY::List>>("Sparse2DArray<List>", size, nonzeros_per_row);
+  run<Sparse2DArray<double, SPARSE_ASSEMBLY::ForwardList>>("Sparse2DArray<ForwardList>", size, nonzeros_per_row);
+  run<Sparse2DArray<double, SPARSE_ASSEMBLY::List, std::uint32_t>>("Sparse2DArray<List,uint32>", size, nonzeros_per_row);
+  run<Sparse2DArray<double, SPARSE_ASSEMBLY::ForwardList, std::uint32_t>>("Sparse2DArray<ForwardList,uint32>", size, nonzeros_per_row);
+
+  return 0;
+}
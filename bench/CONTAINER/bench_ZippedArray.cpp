@@ -0,0 +1,47 @@
+#include "Array.hpp"
+#include "ZippedArray.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+/// 2 つの列の内積を，ZippedArray の走査と 2 つの Array の添字によるループで計算する．
+int main()
+{
+  constexpr std::size_t size = 1 << 16;
+  constexpr std::size_t repeat = 100;
+
+  ZippedArray<double, double> z;
+  Array<double> x;
+  Array<double> y;
+  for(std::size_t i = 0; i < size; ++i){
+    z.push_back(1.0 + 1e-6 * static_cast<double>(i), 2.0);
+    x.push_back(1.0 + 1e-6 * static_cast<double>(i));
+    y.push_back(2.0);
+  }
+
+  BENCH_UTILS::measure("ZippedArray/iteration", size * repeat, [&]()
+  {
+    double sum = 0;
+    for(std::size_t r = 0; r < repeat; ++r){
+      for(auto&& [a, b]: z){
+        sum += a * b;
+      }
+    }
+    BENCH_UTILS::do_not_optimize(sum);
+  });
+
+  BENCH_UTILS::measure("ZippedArray/loop_baseline", size * repeat, [&]()
+  {
+    double sum = 0;
+    for(std::size_t r = 0; r < repeat; ++r){
+      for(std::size_t i = 0; i < size; ++i){
+        sum += x[i] * y[i];
+      }
+    }
+    BENCH_UTILS::do_not_optimize(sum);
+  });
+
+  return 0;
+}
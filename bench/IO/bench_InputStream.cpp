@@ -0,0 +1,146 @@
+#include <cstdio>
+#include <fstream>
+#include "IO.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  constexpr std::size_t lines = 1 << 18;
+
+  // 1 行あたり 32 バイト程度のテキストファイルを作る
+  const std::string path = "bench_InputStream.txt";
+  std::size_t bytes = 0;
+  {
+    std::ofstream file(path);
+    for(std::size_t i = 0; i < lines; ++i){
+      std::string line = std::to_string(i) + "," + std::to_string(i * 7) + ",abcdefghijklmnop\n";
+      bytes += line.size();
+      file << line;
+    }
+  }
+
+  BENCH_UTILS::measure("InputStream/iteration", bytes, [&]()
+  {
+    std::size_t n = 0;
+    for(auto&& c: IO::open<char8_t>(path, IO::IN)){
+      n += (c == u8'\n');
+    }
+    BENCH_UTILS::do_not_optimize(n);
+  });
+
+  BENCH_UTILS::measure("Splitter/lines", bytes, [&]()
+  {
+    std::size_t n = 0;
+    for(auto&& line: IO::split(IO::open<char8_t>(path, IO::IN), u8'\n')){
+      n += line.size();
+    }
+    BENCH_UTILS::do_not_optimize(n);
+  });
+
+  // 文字コードを実行時に指定する場合（仮想関数を介する）とコンパイル時に指定する場合（インライン化される）の比較
+  BENCH_UTILS::measure("InputStream/iteration/utf-8", bytes, [&]()
+  {
+    std::size_t n = 0;
+    for(auto&& c: IO::open<char8_t>(path, IO::IN, "utf-8")){
+      n += (c == u8'\n');
+    }
+    BENCH_UTILS::do_not_optimize(n);
+  });
+
+  BENCH_UTILS::measure("Static/InputStream/iteration/utf-8", bytes, [&]()
+  {
+    std::size_t n = 0;
+    for(auto&& c: IO::open<char8_t>(path, IO::IN, IO::UTF8)){
+      n += (c == u8'\n');
+    }
+    BENCH_UTILS::do_not_optimize(n);
+  });
+
+  BENCH_UTILS::measure("Static/Splitter/lines", bytes, [&]()
+  {
+    std::size_t n = 0;
+    for(auto&& line: IO::split(IO::open<char8_t>(path, IO::IN, IO::ASCII), u8'\n')){
+      n += line.size();
+    }
+    BENCH_UTILS::do_not_optimize(n);
+  });
+
+  // バッファの大きさごとの比較（4 KiB から 4 MiB）
+  for(std::size_t kib = 4; kib <= 4096; kib *= 4){
+    BENCH_UTILS::measure("InputStream/buffer_" + std::to_string(kib) + "KiB", bytes, [&]()
+    {
+      std::size_t n = 0;
+      for(auto&& c: IO::open<char8_t>(path, IO::IN, "ascii", kib << 10)){
+        n += (c == u8'\n');
+      }
+      BENCH_UTILS::do_not_optimize(n);
+    });
+  }
+
+  BENCH_UTILS::measure("ReadAhead/Splitter/lines", bytes, [&]()
+  {
+    std::size_t n = 0;
+    for(auto&& line: IO::split(IO::open<char8_t>(path, IO::ASYNC_IN), u8'\n')){
+      n += line.size();
+    }
+    BENCH_UTILS::do_not_optimize(n);
+  });
+
+  // 改行を memchr でまとめて探し，バッファを指す std::basic_string_view を返す
+  BENCH_UTILS::measure("LineSplitter/lines", bytes, [&]()
+  {
+    std::size_t n = 0;
+    for(auto&& line: IO::lines(IO::open<char8_t>(path, IO::IN))){
+      n += line.value.size();
+    }
+    BENCH_UTILS::do_not_optimize(n);
+  });
+
+  // 行とフィールドへの分割（Splitter を入れ子にする場合と Tokenizer の比較）
+  BENCH_UTILS::measure("Splitter/csv_fields", bytes, [&]()
+  {
+    std::size_t n = 0;
+    for(auto&& line: IO::split(IO::open<char8_t>(path, IO::IN), u8'\n')){
+      for(auto&& field: IO::split(std::u8string_view(line), u8',')){
+        n += field.size();
+      }
+    }
+    BENCH_UTILS::do_not_optimize(n);
+  });
+
+  BENCH_UTILS::measure("Tokenizer/csv_fields", bytes, [&]()
+  {
+    std::size_t n = 0;
+    for(auto&& field: IO::tokenize(IO::open<char8_t>(path, IO::IN), IO::CSV)){
+      n += field.value.size();
+    }
+    BENCH_UTILS::do_not_optimize(n);
+  });
+
+  // ファイルを行の境界で揃えたチャンクに分けて並列に分割する
+  BENCH_UTILS::measure("Parallel/Splitter/lines", bytes, [&]()
+  {
+    std::atomic<std::size_t> n = 0;
+    IO::parallel_for_each_chunk(path, [&](std::u8string_view chunk)
+    {
+      std::size_t m = 0;
+      for(auto&& line: IO::split(chunk, u8'\n')){
+        m += line.size();
+      }
+      n += m;
+    }, u8'\n', 1 << 18);
+    BENCH_UTILS::do_not_optimize(n.load());
+  });
+
+  std::remove(path.c_str());
+
+#if defined(ACCBOOST2_IO_TRACE)
+  IO::report_trace(std::cerr);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include <cstdio>
+#include "IO.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  constexpr std::size_t lines = 1 << 18;
+
+  const std::string path = "bench_OutputStream.txt";
+
+  // 1 行あたり 32 バイト程度を書き込む
+  auto write = [&](auto&& out)
+  {
+    for(std::size_t i = 0; i < lines; ++i){
+      out(i, ",", i * 7, ",abcdefghijklmnop\n");
+    }
+    out.flush();
+  };
+
+  // note: 既存のファイルを切り詰めて書き直すと，ファイルシステムによっては前回分の書き出しを待たされるため，毎回削除しておく．
+  BENCH_UTILS::measure("OutputStream/lines", lines, [&]()
+  {
+    std::remove(path.c_str());
+    write(IO::open<char8_t>(path, IO::OUT));
+  });
+
+  // バッファの大きさごとの比較（4 KiB から 4 MiB）
+  for(std::size_t kib = 4; kib <= 4096; kib *= 4){
+    BENCH_UTILS::measure("OutputStream/buffer_" + std::to_string(kib) + "KiB", lines, [&]()
+    {
+      std::remove(path.c_str());
+      write(IO::open<char8_t>(path, IO::OUT, "ascii", kib << 10));
+    });
+  }
+
+  BENCH_UTILS::measure("Async/OutputStream/lines", lines, [&]()
+  {
+    std::remove(path.c_str());
+    write(IO::open<char8_t>(path, IO::ASYNC_OUT));
+  });
+
+  std::remove(path.c_str());
+
+#if defined(ACCBOOST2_IO_TRACE)
+  IO::report_trace(std::cerr);
+#endif
+
+  return 0;
+}
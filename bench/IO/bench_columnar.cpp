@@ -0,0 +1,71 @@
+#include <cstdio>
+#include "IO.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  constexpr std::size_t n = 1 << 20;
+
+  const std::string text_path = "bench_columnar.txt";
+  const std::string binary_path = "bench_columnar.bin";
+
+  Array<double> x;
+  x.reserve(n);
+  for(std::size_t i = 0; i < n; ++i){
+    x.push_back(static_cast<double>(i) * 0.37 + 1.0 / static_cast<double>(i + 1));
+  }
+  {
+    auto out = IO::open<char8_t>(text_path, IO::OUT);
+    for(auto&& v: x){
+      out(v, "\n");
+    }
+  }
+
+  // テキストを解析する場合と，バイナリ形式で読み込む場合，マップしてそのまま見る場合の比較
+  BENCH_UTILS::measure("Columnar/text_load", n, [&]()
+  {
+    Array<double> y;
+    for(auto&& line: IO::lines(IO::open<char8_t>(text_path, IO::IN))){
+      y.push_back(IO::string_to<double>(line.value));
+    }
+    BENCH_UTILS::do_not_optimize(y.data());
+  });
+
+  BENCH_UTILS::measure("Columnar/save", n, [&]()
+  {
+    std::remove(binary_path.c_str());
+    IO::save(binary_path, x);
+  });
+
+  BENCH_UTILS::measure("Columnar/save/checksum", n, [&]()
+  {
+    std::remove(binary_path.c_str());
+    IO::save(binary_path, x, true);
+  });
+
+  BENCH_UTILS::measure("Columnar/load", n, [&]()
+  {
+    Array<double> y;
+    IO::load(binary_path, y);
+    BENCH_UTILS::do_not_optimize(y.data());
+  });
+
+  BENCH_UTILS::measure("Columnar/view", n, [&]()
+  {
+    const IO::ColumnarFile file(binary_path);
+    double s = 0;
+    for(auto&& v: file.column<double>(0)){
+      s += v;
+    }
+    BENCH_UTILS::do_not_optimize(s);
+  });
+
+  std::remove(text_path.c_str());
+  std::remove(binary_path.c_str());
+
+  return 0;
+}
@@ -0,0 +1,59 @@
+#include <random>
+#include "IO.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+namespace TRANSCODE = IO::BINARY_TOOLS::_impl_transcode;
+
+
+/// From で符号化された s を To に変換する時間を，ASCII の高速化を行う場合と行わない場合（1 文字ずつ変換する）とで比較する．
+template<class From, class To>
+void bench(const std::string& name, const std::basic_string<typename From::unit_type>& s, std::size_t characters)
+{
+  std::basic_string<typename To::unit_type> out(TRANSCODE::max_output_size<From, To>(s.size()), typename To::unit_type{});
+  BENCH_UTILS::measure("transcode/" + name + "/scalar", characters, [&]()
+  {
+    auto result = TRANSCODE::transcode<From, To, false>(s.data(), s.size(), out.data());
+    BENCH_UTILS::do_not_optimize(result.written);
+  });
+  BENCH_UTILS::measure("transcode/" + name, characters, [&]()
+  {
+    auto result = TRANSCODE::transcode<From, To>(s.data(), s.size(), out.data());
+    BENCH_UTILS::do_not_optimize(result.written);
+  });
+}
+
+
+template<class CharType>
+std::basic_string<typename IO::_impl_convert::Encoding<CharType>::type::unit_type> as_units(const std::basic_string<CharType>& s)
+{
+  using UnitType = typename IO::_impl_convert::Encoding<CharType>::type::unit_type;
+  const auto* p = reinterpret_cast<const UnitType*>(s.data());
+  return {p, p + s.size() * sizeof(CharType) / sizeof(UnitType)};
+}
+
+
+int main()
+{
+  constexpr std::size_t characters = 1 << 22;
+
+  // CSV のような ASCII 主体の文字列と，日本語（3 バイトの UTF-8）主体の文字列
+  std::mt19937 random(0);
+  std::u32string ascii, japanese;
+  for(std::size_t i = 0; i < characters; ++i){
+    ascii.push_back(random() % 64 != 0 ? static_cast<char32_t>(U'0' + random() % 10) : static_cast<char32_t>(U'あ' + random() % 80));
+    japanese.push_back(random() % 8 != 0 ? static_cast<char32_t>(U'あ' + random() % 80) : U',');
+  }
+
+  for(auto&& [label, text]: {std::pair{std::string("ascii"), ascii}, std::pair{std::string("japanese"), japanese}}){
+    const auto u8 = as_units(IO::convert<char8_t>(text));
+    const auto u16 = as_units(IO::convert<char16_t>(text));
+    bench<TRANSCODE::U8, TRANSCODE::U32>("utf-8_to_utf-32/" + label, u8, characters);
+    bench<TRANSCODE::U32, TRANSCODE::U8>("utf-32_to_utf-8/" + label, text, characters);
+    bench<TRANSCODE::U16<std::endian::little>, TRANSCODE::U8>("utf-16le_to_utf-8/" + label, u16, characters);
+    bench<TRANSCODE::U8, TRANSCODE::U16<std::endian::little>>("utf-8_to_utf-16le/" + label, u8, characters);
+  }
+
+  return 0;
+}
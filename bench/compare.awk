@@ -0,0 +1,34 @@
+# 基準値（1 つ目のファイル）と計測結果（2 つ目のファイル）を比較し，
+# 基準値の (1 + tolerance) 倍を超えた指標があれば終了ステータス 1 を返す．
+#
+#   awk -v tolerance=0.2 -f compare.awk baseline.tsv results.tsv
+
+BEGIN {
+  FS = "\t"
+  if(tolerance == "") tolerance = 0.2
+  failed = 0
+}
+
+FNR == NR {
+  baseline[$1 FS $2] = $3
+  next
+}
+
+{
+  key = $1 FS $2
+  if(!(key in baseline)){
+    printf "%-48s %-16s %12g %12s  new\n", $1, $2, $3, "-"
+    next
+  }
+  ratio = (baseline[key] > 0) ? $3 / baseline[key] : 1
+  status = "ok"
+  if(ratio > 1 + tolerance){
+    status = "REGRESSION"
+    failed = 1
+  }
+  printf "%-48s %-16s %12g %12g  %+.1f%%  %s\n", $1, $2, $3, baseline[key], (ratio - 1) * 100, status
+}
+
+END {
+  exit failed
+}
@@ -0,0 +1,34 @@
+# 基準値（1 つ目のファイル）に計測結果（2 つ目のファイル）を取り込み，新しい基準値を標準出力に書く．
+# 基準値にない指標は追加し，既にある指標は名前が正規表現 rows に一致するものだけを更新する．
+# 変更していないベンチマークの基準値を測り直しの揺らぎで書き換えないため．
+#
+#   awk -v rows='^Columnar/' -f update_baseline.awk baseline.tsv results.tsv >baseline.tsv.new
+
+BEGIN {
+  FS = "\t"
+  n = 0
+}
+
+FNR == NR {
+  key = $1 FS $2
+  baseline[key] = $0
+  order[++n] = key
+  next
+}
+
+{
+  key = $1 FS $2
+  if((key in baseline) && !(rows != "" && $1 ~ rows)){
+    print baseline[key]
+  }else{
+    print $0
+  }
+  seen[key] = 1
+}
+
+END {
+  # 今回計測しなかった指標はそのまま残す
+  for(i = 1; i <= n; ++i){
+    if(!(order[i] in seen)) print baseline[order[i]]
+  }
+}
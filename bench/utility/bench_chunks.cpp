@@ -0,0 +1,133 @@
+#include "chunks.hpp"
+#include "zip.hpp"
+#include "Array.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+/// y = a * x + y を，ポインタ，zip，chunks<8>，blocked(256) で書いたループで計算する．
+template<class F>
+void run_axpy(const std::string& name, std::size_t size, std::size_t repeat, F&& f)
+{
+  Array<double> x(size, 1.0);
+  Array<double> y(size, 0.0);
+  BENCH_UTILS::measure("chunks/axpy_" + name, size * repeat, [&]()
+  {
+    for(std::size_t r = 0; r < repeat; ++r){
+      f(1.0 + 1e-9 * static_cast<double>(r), x, y);
+    }
+    BENCH_UTILS::do_not_optimize(y[size / 2]);
+  });
+}
+
+
+/**
+ * x と y の内積を計算する．
+ * 浮動小数点数の加算の順序を変えられないので，1 つの和に足し込むループ（ポインタ，zip）は加算の待ち時間で律速され，ベクトル化もされない．
+ * chunks<8> では要素の位置ごとに 8 個の部分和を持つループが書け，-O2 では独立な 8 本の加算として，-O3 ではベクトル化されて速くなる．
+ */
+template<class F>
+void run_dot(const std::string& name, std::size_t size, std::size_t repeat, F&& f)
+{
+  Array<double> x(size, 1.0);
+  Array<double> y(size, 0.5);
+  BENCH_UTILS::measure("chunks/dot_" + name, size * repeat, [&]()
+  {
+    double s = 0;
+    for(std::size_t r = 0; r < repeat; ++r){
+      BENCH_UTILS::do_not_optimize(x[r % size]);
+      s += f(x, y);
+    }
+    BENCH_UTILS::do_not_optimize(s);
+  });
+}
+
+
+int main()
+{
+  constexpr std::size_t size = 4096;
+  constexpr std::size_t repeat = 10000;
+
+  run_axpy("pointer", size, repeat, [](double a, const Array<double>& x, Array<double>& y)
+  {
+    const double* p = x.begin();
+    double* q = y.begin();
+    for(std::size_t i = 0, n = x.size(); i < n; ++i){
+      q[i] += a * p[i];
+    }
+  });
+
+  run_axpy("zip", size, repeat, [](double a, const Array<double>& x, Array<double>& y)
+  {
+    for(auto&& [xi, yi]: zip(x, y)){
+      yi += a * xi;
+    }
+  });
+
+  run_axpy("chunks8", size, repeat, [](double a, const Array<double>& x, Array<double>& y)
+  {
+    auto c = chunks<8>(x, y);
+    for(auto&& [xb, yb]: c){
+      for(std::size_t i = 0; i < xb.size(); ++i){
+        yb[i] += a * xb[i];
+      }
+    }
+    auto&& [xr, yr] = c.remainder();
+    for(std::size_t i = 0; i < xr.size(); ++i){
+      yr[i] += a * xr[i];
+    }
+  });
+
+  run_axpy("blocked256", size, repeat, [](double a, const Array<double>& x, Array<double>& y)
+  {
+    for(auto&& [xb, yb]: blocked(256, x, y)){
+      for(std::size_t i = 0; i < xb.size(); ++i){
+        yb[i] += a * xb[i];
+      }
+    }
+  });
+
+  run_dot("pointer", size, repeat, [](const Array<double>& x, const Array<double>& y)
+  {
+    const double* p = x.begin();
+    const double* q = y.begin();
+    double s = 0;
+    for(std::size_t i = 0, n = x.size(); i < n; ++i){
+      s += p[i] * q[i];
+    }
+    return s;
+  });
+
+  run_dot("zip", size, repeat, [](const Array<double>& x, const Array<double>& y)
+  {
+    double s = 0;
+    for(auto&& [xi, yi]: zip(x, y)){
+      s += xi * yi;
+    }
+    return s;
+  });
+
+  run_dot("chunks8", size, repeat, [](const Array<double>& x, const Array<double>& y)
+  {
+    double partial[8] = {};
+    auto c = chunks<8>(x, y);
+    for(auto&& [xb, yb]: c){
+      for(std::size_t i = 0; i < 8; ++i){
+        partial[i] += xb[i] * yb[i];
+      }
+    }
+    double s = 0;
+    for(std::size_t i = 0; i < 8; ++i){
+      s += partial[i];
+    }
+    auto&& [xr, yr] = c.remainder();
+    for(std::size_t i = 0; i < xr.size(); ++i){
+      s += xr[i] * yr[i];
+    }
+    return s;
+  });
+
+  return 0;
+}
@@ -0,0 +1,80 @@
+#include "for_each.hpp"
+#include "range.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+/// 0 <= i < size について i * i の和（filter_map は 3 の倍数の i のみ）を，手書きのループ，範囲 for 文，reduce で計算する．
+int main()
+{
+  constexpr std::size_t size = 1 << 20;
+  constexpr std::size_t repeat = 20;
+
+  auto is_target = [](std::size_t i){return i % 3 == 0;};
+  auto square = [](std::size_t i){return i * i;};
+  auto plus = [](std::size_t a, std::size_t b){return a + b;};
+
+  auto run = [&](const std::string& name, auto&& f)
+  {
+    BENCH_UTILS::measure("for_each/" + name, size * repeat, [&]()
+    {
+      std::size_t sum = 0;
+      for(std::size_t r = 0; r < repeat; ++r){
+        std::size_t n = size - (r & 1);
+        BENCH_UTILS::do_not_optimize(n);
+        sum += f(n);
+      }
+      BENCH_UTILS::do_not_optimize(sum);
+    });
+  };
+
+  run("map_loop", [&](std::size_t n)
+  {
+    std::size_t sum = 0;
+    for(std::size_t i = 0; i < n; ++i){
+      sum += square(i);
+    }
+    return sum;
+  });
+
+  run("map_range_for", [&](std::size_t n)
+  {
+    std::size_t sum = 0;
+    for(auto&& y: map(square, range(n))){
+      sum += y;
+    }
+    return sum;
+  });
+
+  run("map_reduce", [&](std::size_t n)
+  {
+    return reduce(plus, std::size_t(0), map(square, range(n)));
+  });
+
+  run("filter_map_loop", [&](std::size_t n)
+  {
+    std::size_t sum = 0;
+    for(std::size_t i = 0; i < n; ++i){
+      if(is_target(i)) sum += square(i);
+    }
+    return sum;
+  });
+
+  run("filter_map_range_for", [&](std::size_t n)
+  {
+    std::size_t sum = 0;
+    for(auto&& y: map(square, filter(is_target, range(n)))){
+      sum += y;
+    }
+    return sum;
+  });
+
+  run("filter_map_reduce", [&](std::size_t n)
+  {
+    return reduce(plus, std::size_t(0), map(square, filter(is_target, range(n))));
+  });
+
+  return 0;
+}
@@ -0,0 +1,35 @@
+# 1 つ目のファイル（ソースコード）で行末に「// expect-vectorized」が付いた行のループが，
+# 2 つ目のファイル（コンパイラの最適化レポート）でベクトル化されたと報告されているかを確認する．
+#
+#   GCC:   -fopt-info-vec-optimized   （「file:line:column: optimized: loop vectorized ...」）
+#   Clang: -Rpass=loop-vectorize      （「file:line:column: remark: vectorized loop ...」）
+#
+#   awk -v source=zero_overhead.cpp -f check_vectorized.awk zero_overhead.cpp remarks.txt
+
+BEGIN {
+  failed = 0
+}
+
+FNR == NR {
+  if($0 ~ /\/\/ expect-vectorized[ \t]*$/){
+    expected[FNR] = $0
+  }
+  next
+}
+
+index($0, source ":") == 1 && ($0 ~ /loop vectorized/ || $0 ~ /vectorized loop/) {
+  split(substr($0, length(source) + 2), position, ":")
+  vectorized[position[1] + 0] = 1
+}
+
+END {
+  for(line in expected){
+    if(line in vectorized){
+      printf "%s:%d: vectorized\n", source, line
+    }else{
+      printf "%s:%d: NOT vectorized:%s\n", source, line, expected[line]
+      failed = 1
+    }
+  }
+  exit failed
+}
@@ -0,0 +1,190 @@
+#include <cstdint>
+#include <cstdlib>
+#include "Array.hpp"
+#include "ZippedArray.hpp"
+#include "BENCH_UTILS.hpp"
+
+
+// 抽象化したループと，同じ処理を手で書いたループの組．
+// 「expect-vectorized」を付けたループは，check_vectorized.awk で -O3 のときにベクトル化されたことを確認する．
+
+
+using namespace ACCBOOST2;
+
+
+ACCBOOST2_NOINLINE void axpy_zip(std::int64_t a, const Array<std::int64_t>& x, Array<std::int64_t>& y)
+{
+  for(auto&& [xi, yi]: zip(x, y)){ // expect-vectorized
+    yi += a * xi;
+  }
+}
+
+ACCBOOST2_NOINLINE void axpy_loop(std::int64_t a, const Array<std::int64_t>& x, Array<std::int64_t>& y)
+{
+  const std::int64_t* p = x.data();
+  std::int64_t* q = y.data();
+  for(std::size_t i = 0, n = std::min(x.size(), y.size()); i < n; ++i){ // expect-vectorized
+    q[i] += a * p[i];
+  }
+}
+
+ACCBOOST2_NOINLINE std::int64_t sum_map(const Array<std::int64_t>& x)
+{
+  // note: 64 ビット整数の和の畳み込みは，手で書いたループでも GCC 12 (x86-64) ではベクトル化されない．
+  std::int64_t sum = 0;
+  for(auto&& y: map([](std::int64_t v){return v * 2 + 1;}, x)){
+    sum += y;
+  }
+  return sum;
+}
+
+ACCBOOST2_NOINLINE std::int64_t sum_map_loop(const Array<std::int64_t>& x)
+{
+  std::int64_t sum = 0;
+  for(std::size_t i = 0, n = x.size(); i < n; ++i){
+    sum += x[i] * 2 + 1;
+  }
+  return sum;
+}
+
+ACCBOOST2_NOINLINE void add_range(const Array<std::int64_t>& x, Array<std::int64_t>& y)
+{
+  const std::int64_t* p = x.data();
+  std::int64_t* q = y.data();
+  for(auto i: range(std::min(x.size(), y.size()))){ // expect-vectorized
+    q[i] += p[i] + 1;
+  }
+}
+
+ACCBOOST2_NOINLINE void add_range_loop(const Array<std::int64_t>& x, Array<std::int64_t>& y)
+{
+  const std::int64_t* p = x.data();
+  std::int64_t* q = y.data();
+  for(std::size_t i = 0, n = std::min(x.size(), y.size()); i < n; ++i){ // expect-vectorized
+    q[i] += p[i] + 1;
+  }
+}
+
+ACCBOOST2_NOINLINE void add_enumerate(Array<std::int64_t>& x)
+{
+  for(auto&& [i, v]: enumerate(x)){ // expect-vectorized
+    v += static_cast<std::int64_t>(i);
+  }
+}
+
+ACCBOOST2_NOINLINE void add_enumerate_loop(Array<std::int64_t>& x)
+{
+  std::int64_t* p = x.data();
+  for(std::size_t i = 0, n = x.size(); i < n; ++i){ // expect-vectorized
+    p[i] += static_cast<std::int64_t>(i);
+  }
+}
+
+ACCBOOST2_NOINLINE void add_zipped_array(ZippedArray<std::int64_t, std::int64_t>& z)
+{
+  for(auto&& [a, b]: z){ // expect-vectorized
+    b += a;
+  }
+}
+
+ACCBOOST2_NOINLINE void add_zipped_array_loop(const Array<std::int64_t>& x, Array<std::int64_t>& y)
+{
+  const std::int64_t* p = x.data();
+  std::int64_t* q = y.data();
+  for(std::size_t i = 0, n = std::min(x.size(), y.size()); i < n; ++i){ // expect-vectorized
+    q[i] += p[i];
+  }
+}
+
+ACCBOOST2_NOINLINE void copy_reverse(const Array<std::int64_t>& x, Array<std::int64_t>& y)
+{
+  for(auto&& [a, b]: zip(reverse(x), y)){ // expect-vectorized
+    b = a;
+  }
+}
+
+ACCBOOST2_NOINLINE void copy_reverse_loop(const Array<std::int64_t>& x, Array<std::int64_t>& y)
+{
+  const std::int64_t* p = x.data();
+  std::int64_t* q = y.data();
+  for(std::size_t i = 0, n = std::min(x.size(), y.size()); i < n; ++i){ // expect-vectorized
+    q[i] = p[n - 1 - i];
+  }
+}
+
+ACCBOOST2_NOINLINE std::int64_t sum_chain(const Array<std::int64_t>& x, const Array<std::int64_t>& y)
+{
+  // note: chain は要素ごとに部分範囲の終端と全体の終端を比べるので，2 つのループに分けたものと同じにはならない．
+  std::int64_t sum = 0;
+  for(auto&& v: chain(x, y)){
+    sum += v;
+  }
+  return sum;
+}
+
+ACCBOOST2_NOINLINE std::int64_t sum_chain_loop(const Array<std::int64_t>& x, const Array<std::int64_t>& y)
+{
+  std::int64_t sum = 0;
+  for(std::size_t i = 0, n = x.size(); i < n; ++i){
+    sum += x[i];
+  }
+  for(std::size_t i = 0, n = y.size(); i < n; ++i){
+    sum += y[i];
+  }
+  return sum;
+}
+
+
+/// 抽象化したループの時間と手で書いたループの時間の比を出力し，許容値を超えていれば false を返す．
+template<class F, class G>
+bool compare(const std::string& name, const std::string& label, double max_overhead, std::size_t items, F&& f, G&& g)
+{
+  constexpr std::size_t repeat = 2000;
+  auto run = [&](auto& h)
+  {
+    for(std::size_t r = 0; r < repeat; ++r) h();
+  };
+  double abstraction = BENCH_UTILS::measure("zero_overhead/" + name + "[" + label + "]", items * repeat, [&](){run(f);}, 7);
+  double baseline = BENCH_UTILS::measure("zero_overhead/" + name + "_loop[" + label + "]", items * repeat, [&](){run(g);}, 7);
+  double ratio = abstraction / baseline;
+  BENCH_UTILS::report("zero_overhead/" + name + "[" + label + "]", "ratio", ratio);
+  if(ratio > 1 + max_overhead){
+    std::cerr << "zero_overhead/" << name << "[" << label << "] is " << (ratio - 1) * 100 << "% slower than the hand-written loop." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+
+/// ./zero_overhead.out 許容割合 ラベル chain の許容割合
+int main(int argc, char* argv[])
+{
+  const double max_overhead = argc > 1 ? std::atof(argv[1]) : 0.1;
+  const std::string label = argc > 2 ? argv[2] : "";
+  // note: chain は手で書いたループより GCC 12 で 25% (-O2)，30〜70% (-O3) ほど遅いので，別の許容割合でこれ以上悪化しないことだけを確認する．
+  const double max_chain_overhead = argc > 3 ? std::atof(argv[3]) : 1.0;
+
+  constexpr std::size_t size = 4096;
+  Array<std::int64_t> x;
+  Array<std::int64_t> y;
+  ZippedArray<std::int64_t, std::int64_t> z;
+  for(std::size_t i = 0; i < size; ++i){
+    x.push_back(static_cast<std::int64_t>(i % 17));
+    y.push_back(0);
+    z.push_back(static_cast<std::int64_t>(i % 17), 0);
+  }
+
+  // note: 定数にすると，片方だけが定数伝播で特殊化されて比較にならないことがある．
+  const std::int64_t a = argc + 2;
+
+  bool ok = true;
+  ok &= compare("axpy_zip", label, max_overhead, size, [&](){axpy_zip(a, x, y);}, [&](){axpy_loop(a, x, y);});
+  ok &= compare("sum_map", label, max_overhead, size, [&](){BENCH_UTILS::do_not_optimize(sum_map(x));}, [&](){BENCH_UTILS::do_not_optimize(sum_map_loop(x));});
+  ok &= compare("add_range", label, max_overhead, size, [&](){add_range(x, y);}, [&](){add_range_loop(x, y);});
+  ok &= compare("add_enumerate", label, max_overhead, size, [&](){add_enumerate(y);}, [&](){add_enumerate_loop(y);});
+  ok &= compare("add_zipped_array", label, max_overhead, size, [&](){add_zipped_array(z);}, [&](){add_zipped_array_loop(x, y);});
+  ok &= compare("copy_reverse", label, max_overhead, size, [&](){copy_reverse(x, y);}, [&](){copy_reverse_loop(x, y);});
+  ok &= compare("sum_chain", label, max_chain_overhead, 2 * size, [&](){BENCH_UTILS::do_not_optimize(sum_chain(x, y));}, [&](){BENCH_UTILS::do_not_optimize(sum_chain_loop(x, y));});
+
+  return ok ? 0 : 1;
+}
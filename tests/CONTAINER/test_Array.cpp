@@ -19,4 +19,15 @@ int main()
     std::cout << x << std::endl;
   }
 
+  // 連続した領域を持つ範囲からの expand
+  static_assert(std::ranges::contiguous_range<decltype(slice(1, 3, a))>);
+  static_assert(std::ranges::sized_range<decltype(slice(1, 3, a))>);
+  Array<double> c;
+  c.expand(slice(1, 3, a));
+  c.expand(slice(4, 6, a));
+
+  for(auto&& x: c){
+    std::cout << x << std::endl;
+  }
+
 }
\ No newline at end of file
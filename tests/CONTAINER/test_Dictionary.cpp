@@ -0,0 +1,57 @@
+
+
+#include <iostream>
+#include <string>
+
+#include "Dictionary.hpp"
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  Dictionary<std::string, double> d;
+
+  d.add(std::string("a"), 1.0);
+
+  {
+    auto [value, added] = d.try_emplace(std::string("a"), 2.0);
+    std::cout << value << " " << added << std::endl;
+  }
+  {
+    auto [value, added] = d.try_emplace(std::string("b"), 2.0);
+    std::cout << value << " " << added << std::endl;
+  }
+
+  d.emplace_or_update(std::string("b"), [](double& x){x *= 10;});
+  d.emplace_or_update(std::string("c"), [](double& x){x += 3;});
+
+  d.accumulate(std::string("a"), 0.5);
+  d.accumulate(std::string("d"), 4.0);
+
+  for(auto&& [key, value]: d){
+    std::cout << key << " " << value << std::endl;
+  }
+
+  {
+    Dictionary<int, int> e;
+    e.reserve(1000);
+    auto bucket_count = e.bucket_count();
+    for(int k = 0; k < 1000; ++k){
+      e.add(k * 37, k);
+    }
+    auto statistics = e.probe_statistics();
+    std::cout << (e.bucket_count() == bucket_count) << " " << e.load_factor() * bucket_count << " "
+      << (statistics.average_probe_length >= 1) << " " << (statistics.max_probe_length >= 1) << std::endl;
+  }
+
+  {
+    Dictionary<std::array<std::uint32_t, 2>, double> f;
+    f.add(std::array<std::uint32_t, 2>{1, 2}, 3.0);
+    f.accumulate(std::array<std::uint32_t, 2>{1, 2}, 1.0);
+    f.accumulate(std::array<std::uint32_t, 2>{2, 1}, 1.0);
+    std::cout << f[std::array<std::uint32_t, 2>{1, 2}] << " " << f[std::array<std::uint32_t, 2>{2, 1}] << std::endl;
+  }
+
+}
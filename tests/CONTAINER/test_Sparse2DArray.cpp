@@ -0,0 +1,90 @@
+
+
+#include <iostream>
+
+#include "Sparse2DArray.hpp"
+
+
+template<class Sparse2DArrayType>
+void test_erase()
+{
+  Sparse2DArrayType a(4, 4);
+  for(std::size_t k = 0; k < 16; ++k){
+    a.emplace(k % 4, k / 4, static_cast<double>(k));
+  }
+  a.erase(1, 1);
+  a.erase(3, 3);
+  a.erase(0, 0);
+  a.clear_row(2);
+  a.clear_column(0);
+  for(std::size_t i = 0; i < a.row_size(); ++i){
+    for(auto&& [r, c, v]: a.row(i)){
+      std::cout << "(" << r << "," << c << ")=" << v << " ";
+    }
+  }
+  std::cout << std::endl;
+  for(std::size_t j = 0; j < a.column_size(); ++j){
+    for(auto&& [r, c, v]: a.column(j)){
+      std::cout << "(" << r << "," << c << ")=" << v << " ";
+    }
+  }
+  std::cout << std::endl;
+  Sparse2DArrayType b(a);
+  b.clear();
+  a.emplace(2, 2, 1.0);
+  std::cout << b.contain(0, 1) << " " << a.contain(0, 1) << " " << a.get(2, 2) << std::endl;
+}
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  Sparse2DArray<double> a(3, 3);
+
+  a.emplace(0, 1, 1.0);
+  a.emplace(0, 1, 2.0);
+
+  {
+    auto [value, added] = a.try_emplace(0, 1, 5.0);
+    std::cout << value << " " << added << std::endl;
+  }
+  {
+    auto [value, added] = a.try_emplace(2, 0, 5.0);
+    std::cout << value << " " << added << std::endl;
+  }
+
+  a.emplace_or_update(2, 0, [](double& x){x *= 2;});
+  a.emplace_or_update(1, 2, [](double& x){x += 1;});
+
+  for(std::size_t k = 0; k < 10; ++k){
+    a.accumulate(k % 3, (k * 2) % 3, 1.0);
+  }
+
+  std::cout << a.contain(1, 1) << " " << a.contain(2, 2) << std::endl;
+
+  for(std::size_t i = 0; i < a.row_size(); ++i){
+    for(auto&& [r, c, v]: a.row(i)){
+      std::cout << r << " " << c << " " << v << std::endl;
+    }
+  }
+
+  test_erase<Sparse2DArray<double>>();
+  test_erase<Sparse2DArray<double, SPARSE_ASSEMBLY::ForwardList>>();
+  test_erase<Sparse2DArray<double, SPARSE_ASSEMBLY::List, std::uint32_t>>();
+  test_erase<Sparse2DArray<double, SPARSE_ASSEMBLY::ForwardList, std::uint32_t>>();
+
+  {
+    Sparse2DArray<double> b(100, 100);
+    b.reserve(1000);
+    auto bucket_count = b.bucket_count();
+    for(std::size_t k = 0; k < 1000; ++k){
+      b.emplace(k / 100 * 7 % 100, k % 100, 1.0);
+    }
+    auto statistics = b.probe_statistics();
+    std::cout << (b.bucket_count() == bucket_count) << " " << b.load_factor() * bucket_count << " "
+      << (statistics.average_probe_length >= 1) << " " << (statistics.max_probe_length >= 1) << std::endl;
+  }
+
+}
@@ -0,0 +1,58 @@
+#define ACCBOOST2_MEMORY_STATISTICS
+
+#include <iostream>
+
+#include "Dictionary.hpp"
+#include "Sparse2DArray.hpp"
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  {
+    Array<int> a;
+    for(int i = 0; i < 100; ++i){
+      a.push_back(i);
+    }
+    auto s = a.stats();
+    std::cout << s.allocations << " " << (s.reserved_bytes == a.capacity() * sizeof(int)) << " " << s.live_bytes << std::endl;
+  }
+
+  {
+    MEMORY::MemoryPool<double> pool;
+    pool.reserve(10);
+    double* x = pool.create(1.0);
+    auto s = pool.stats();
+    std::cout << s.allocations << " " << s.live_bytes << " " << s.occupancy << std::endl;
+    pool.destroy(x);
+  }
+
+  std::cout << MEMORY::Registry::global().size() << std::endl;
+
+  {
+    Dictionary<int, int> d;
+    for(int i = 0; i < 100; ++i){
+      d.add(i, i);
+    }
+    Sparse2DArray<double> m(10, 10);
+    m.emplace(1, 2, 3.0);
+    std::cout << MEMORY::Registry::global().size() << std::endl;
+
+    auto s = d.stats();
+    std::cout << s.rehashes << " " << (s.allocations > s.rehashes) << " " << (s.reserved_bytes >= s.live_bytes) << " " << (s.max_probe_length >= 1) << std::endl;
+
+    Dictionary<int, int> e(std::move(d));
+    std::cout << MEMORY::Registry::global().size() << " " << e.stats().rehashes << " " << d.stats().rehashes << std::endl;
+
+    MEMORY::Registry::global().for_each([](const char* name, const void*, const MEMORY::Statistics& statistics)
+    {
+      std::cout << name << " " << (statistics.live_bytes != 0) << std::endl;
+    });
+  }
+
+  std::cout << MEMORY::Registry::global().size() << std::endl;
+
+  return 0;
+}
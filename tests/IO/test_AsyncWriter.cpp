@@ -0,0 +1,132 @@
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include "IO.hpp"
+
+
+std::string read_file(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+
+/// 呼ばれた関数を log に記録する BinaryWriter．
+class LoggingWriter: public ACCBOOST2::IO::BINARY_TOOLS::BinaryWriter
+{
+private:
+
+  std::string& log_;
+
+public:
+
+  explicit LoggingWriter(std::string& log): log_(log)
+  {}
+
+  void operator()(const std::byte*, std::size_t size) override
+  {
+    log_ += "write(" + std::to_string(size) + ") ";
+  }
+
+  void flush() override
+  {
+    log_ += "flush ";
+  }
+
+  void close() override
+  {
+    log_ += "close ";
+  }
+
+};
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  const std::string path = "test_AsyncWriter.tmp";
+
+  std::string content;
+  for(int i = 0; i < 2000; ++i){
+    content += std::to_string(i) + "\n";
+  }
+
+  for(std::size_t number_of_buffers: {1, 2, 4}){
+    for(std::size_t buffer_size: {1, 7, 4096, 1 << 20}){
+      {
+        IO::OutputStream<char8_t> out(IO::BINARY_TOOLS::make_encoder<char8_t>(IO::BINARY_TOOLS::make_async_writer(IO::BINARY_TOOLS::make_binary_file_writer(path), number_of_buffers, buffer_size), "utf-8"), 5);
+        for(int i = 0; i < 1000; ++i){
+          out(i, "\n");
+        }
+        // flush() は書き込みが終わるまで待つ
+        out.flush();
+        const std::string half = read_file(path);
+        std::cout << (half == content.substr(0, half.size()) && half.size() == content.find("1000\n")) << " ";
+        for(int i = 1000; i < 2000; ++i){
+          out(i, "\n");
+        }
+      }
+      std::cout << (read_file(path) == content) << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  {
+    auto out = IO::open<char8_t>(path, IO::ASYNC_OUT);
+    out(u8"abc\n");
+    out.close();
+    std::cout << read_file(path);
+  }
+
+  {
+    // 書き込み側のスレッドの失敗は close() で投げられる
+    auto out = IO::open<char8_t>("/dev/full", IO::ASYNC_OUT, "ascii", 16);
+    try{
+      for(int i = 0; i < 100; ++i){
+        out(i, "\n");
+      }
+      out.close();
+      std::cout << "not thrown" << std::endl;
+    }catch(std::runtime_error& e){
+      std::cout << e.what() << std::endl;
+    }
+  }
+
+  {
+    // デストラクタは例外を投げない
+    auto out = IO::open<char8_t>("/dev/full", IO::ASYNC_OUT, "ascii", 16);
+    out(u8"abc\n");
+  }
+
+  {
+    // close() の後は，デストラクタも flush() も下層の writer に触れない
+    std::string log;
+    {
+      IO::OutputStream<std::byte> out(IO::BINARY_TOOLS::make_async_writer(std::make_unique<LoggingWriter>(log), 2, 4), 3);
+      out(std::byte{1});
+      out(std::byte{2});
+      out.close();
+      out.flush();
+    }
+    std::cout << log << std::endl;
+    log.clear();
+    {
+      auto writer = IO::BINARY_TOOLS::make_async_writer(std::make_unique<LoggingWriter>(log), 2, 4);
+      const std::byte data[5] = {};
+      (*writer)(data, 5);
+      writer->close();
+      writer->flush();
+      writer->close();
+    }
+    std::cout << log << std::endl;
+  }
+
+  std::remove(path.c_str());
+
+}
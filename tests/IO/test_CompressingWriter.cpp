@@ -0,0 +1,129 @@
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include "IO.hpp"
+
+
+std::string read_bytes(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+
+void print_magic_number(const std::string& path)
+{
+  const std::string bytes = read_bytes(path);
+  for(std::size_t i = 0; i < std::min<std::size_t>(bytes.size(), 4); ++i){
+    std::cout << std::hex << (static_cast<unsigned>(bytes[i]) & 0xFF) << std::dec << " ";
+  }
+}
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  std::u8string content;
+  for(int i = 0; i < 20000; ++i){
+    content += IO::convert<char8_t>(std::to_string(i) + "," + std::to_string(i * 7) + ",abcdefghij\n");
+  }
+
+#if defined(ACCBOOST2_IO_ZLIB)
+  {
+    const std::string path = "test_CompressingWriter.tmp.gz";
+    for(unsigned number_of_threads: {0u, 2u}){
+      for(std::optional<int> level: {std::optional<int>(), std::optional<int>(1), std::optional<int>(9)}){
+        {
+          auto out = IO::open<char8_t>(path, IO::OUT, "utf-8", 1000, {level, number_of_threads});
+          for(std::size_t i = 0; i < content.size(); i += 777){
+            out(std::u8string_view(content).substr(i, 777));
+            if(i == 777 * 100){
+              // 途中で書き出しても 1 つのストリームのまま続けられる
+              out.flush();
+            }
+          }
+          out.close();
+        }
+        print_magic_number(path);
+        std::cout << (read_bytes(path).size() < content.size() / 3) << " ";
+        std::cout << (IO::open<char8_t>(path, IO::IN).read() == content) << " ";
+        {
+          auto out = IO::open<char8_t>(path, IO::ASYNC_OUT, "ascii", 0, {level, number_of_threads});
+          out(std::u8string_view(content));
+        }
+        std::cout << (IO::open<char8_t>(path, IO::IN).read() == content) << std::endl;
+      }
+    }
+    {
+      // 何も書き込まなくても空の gzip ストリームになる
+      IO::open<char8_t>(path, IO::OUT).close();
+      print_magic_number(path);
+      std::cout << IO::open<char8_t>(path, IO::IN).read().size() << std::endl;
+    }
+    try{
+      IO::open<char8_t>(path, IO::OUT, "ascii", 0, {42, 0});
+      std::cout << "not thrown" << std::endl;
+    }catch(std::runtime_error& e){
+      std::cout << e.what() << std::endl;
+    }
+    std::remove(path.c_str());
+  }
+
+  for(unsigned number_of_threads: {0u, 2u}){
+    // 書き込みの失敗は close() で投げられる
+    IO::OutputStream<char8_t> out(IO::BINARY_TOOLS::make_encoder<char8_t>(IO::BINARY_TOOLS::make_gzip_writer(IO::BINARY_TOOLS::make_binary_file_writer("/dev/full"), {std::nullopt, number_of_threads}), "ascii"));
+    try{
+      out(u8"abc\n");
+      out.close();
+      std::cout << "not thrown" << std::endl;
+    }catch(std::runtime_error& e){
+      std::cout << e.what() << std::endl;
+    }
+  }
+
+  {
+    // デストラクタは例外を投げない
+    IO::OutputStream<char8_t> out(IO::BINARY_TOOLS::make_encoder<char8_t>(IO::BINARY_TOOLS::make_gzip_writer(IO::BINARY_TOOLS::make_binary_file_writer("/dev/full")), "ascii"));
+    out(u8"abc\n");
+  }
+#endif
+
+  {
+    const std::string path = "test_CompressingWriter.tmp.zst";
+#if defined(ACCBOOST2_IO_ZSTD)
+    for(unsigned number_of_threads: {0u, 2u}){
+      {
+        auto out = IO::open<char8_t>(path, IO::OUT, "utf-8", 1000, {3, number_of_threads});
+        out(std::u8string_view(content));
+      }
+      print_magic_number(path);
+      std::cout << (IO::open<char8_t>(path, IO::IN).read() == content) << std::endl;
+    }
+    for(unsigned number_of_threads: {0u, 2u}){
+      IO::OutputStream<char8_t> out(IO::BINARY_TOOLS::make_encoder<char8_t>(IO::BINARY_TOOLS::make_zstd_writer(IO::BINARY_TOOLS::make_binary_file_writer("/dev/full"), {std::nullopt, number_of_threads}), "ascii"));
+      try{
+        out(u8"abc\n");
+        out.close();
+        std::cout << "not thrown" << std::endl;
+      }catch(std::runtime_error& e){
+        std::cout << e.what() << std::endl;
+      }
+    }
+#else
+    try{
+      IO::open<char8_t>(path, IO::OUT);
+      std::cout << "not thrown" << std::endl;
+    }catch(std::runtime_error& e){
+      std::cout << e.what() << std::endl;
+    }
+#endif
+    std::remove(path.c_str());
+  }
+
+}
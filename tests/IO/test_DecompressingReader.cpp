@@ -0,0 +1,173 @@
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "IO.hpp"
+
+
+void write_bytes(const std::string& path, const std::string& bytes)
+{
+  std::ofstream file(path, std::ios::binary);
+  file.write(bytes.data(), bytes.size());
+}
+
+
+#if defined(ACCBOOST2_IO_ZLIB)
+
+/// data を 1 つのメンバーからなる gzip 形式に圧縮する．
+std::string gzip(const std::string& data)
+{
+  z_stream stream{};
+  if(::deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) throw std::runtime_error("deflateInit2() failure.");
+  std::string result(::deflateBound(&stream, data.size()), '\0');
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = data.size();
+  stream.next_out = reinterpret_cast<Bytef*>(result.data());
+  stream.avail_out = result.size();
+  ::deflate(&stream, Z_FINISH);
+  result.resize(stream.total_out);
+  ::deflateEnd(&stream);
+  return result;
+}
+
+#endif
+
+
+/// data を無圧縮のブロックだけからなる zstd のフレームにする．
+std::string zstd_raw_frame(const std::string& data)
+{
+  // フレームヘッダー（Window_Descriptor で 1 KiB のウィンドウを指定する）
+  std::string result("\x28\xB5\x2F\xFD\x00\x00", 6);
+  std::size_t first = 0;
+  do{
+    const std::size_t n = std::min<std::size_t>(data.size() - first, 1000);
+    const std::uint32_t block_header = (first + n == data.size() ? 1 : 0) | static_cast<std::uint32_t>(n << 3);
+    result.push_back(static_cast<char>(block_header & 0xFF));
+    result.push_back(static_cast<char>((block_header >> 8) & 0xFF));
+    result.push_back(static_cast<char>((block_header >> 16) & 0xFF));
+    result.append(data, first, n);
+    first += n;
+  }while(first != data.size());
+  return result;
+}
+
+
+void print_read(const std::string& path, std::size_t buffer_size = 0)
+{
+  try{
+    const auto content = ACCBOOST2::IO::open<char8_t>(path, ACCBOOST2::IO::IN, "ascii", buffer_size).read();
+    std::cout << content.size() << std::endl;
+  }catch(std::runtime_error& e){
+    std::cout << e.what() << std::endl;
+  }
+}
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  const std::string path = "test_DecompressingReader.tmp";
+
+  std::string content;
+  for(int i = 0; i < 20000; ++i){
+    content += std::to_string(i) + ",abcdefg\n";
+  }
+  const std::u8string expected(content.begin(), content.end());
+
+  // 圧縮されていないファイル（マジックナンバーより短いものを含む）
+  write_bytes(path, content);
+  std::cout << (IO::open<char8_t>(path, IO::IN).read() == expected) << " ";
+  std::cout << (IO::open<char8_t>(path, IO::ASYNC_IN).read() == expected) << std::endl;
+  write_bytes(path, "");
+  print_read(path);
+  write_bytes(path, "\x1F");
+  print_read(path);
+  write_bytes(path, "\x28\xB5\x2F");
+  print_read(path);
+
+#if defined(ACCBOOST2_IO_ZLIB)
+  {
+    const std::string compressed = gzip(content);
+    write_bytes(path, compressed);
+    std::cout << (IO::open<char8_t>(path, IO::IN).read() == expected) << " ";
+    std::cout << (IO::open<char8_t>(path, IO::IN, "utf-8", 1024).read() == expected) << " ";
+    std::cout << (IO::open<char8_t>(path, IO::ASYNC_IN, "ascii", 7).read() == expected) << " ";
+    {
+      // make_gzip_reader はマジックナンバーを調べずに伸長する
+      IO::InputStream<char8_t> stream(IO::BINARY_TOOLS::make_decoder<char8_t>(IO::BINARY_TOOLS::make_gzip_reader(IO::BINARY_TOOLS::make_binary_file_reader(path)), "ascii"));
+      std::cout << (stream.read() == expected) << " ";
+    }
+    std::size_t count = 0;
+    for(auto&& line: IO::lines(IO::open<char8_t>(path, IO::IN))){
+      count += !line.value.empty();
+    }
+    std::cout << count << std::endl;
+
+    // 複数のメンバーを連結したもの
+    write_bytes(path, gzip("abc\n") + gzip("") + gzip("def\n"));
+    {
+      const auto result = IO::open<char8_t>(path, IO::IN).read();
+      std::cout << std::string(result.begin(), result.end());
+    }
+
+    // 途切れたものと壊れたもの
+    write_bytes(path, compressed.substr(0, compressed.size() / 2));
+    print_read(path);
+    write_bytes(path, compressed.substr(0, compressed.size() - 1));
+    print_read(path);
+    std::string broken = compressed;
+    broken[20] = static_cast<char>(~broken[20]);
+    broken[21] = static_cast<char>(~broken[21]);
+    write_bytes(path, broken);
+    try{
+      IO::open<char8_t>(path, IO::IN).read();
+      std::cout << "not thrown" << std::endl;
+    }catch(std::runtime_error& e){
+      // zlib のメッセージは除く
+      const std::string message = e.what();
+      std::cout << message.substr(0, message.find(':')) << std::endl;
+    }
+  }
+#else
+  write_bytes(path, "\x1F\x8B\x08");
+  print_read(path);
+#endif
+
+  {
+    write_bytes(path, zstd_raw_frame(content));
+#if defined(ACCBOOST2_IO_ZSTD)
+    std::cout << (IO::open<char8_t>(path, IO::IN).read() == expected) << " ";
+    std::cout << (IO::open<char8_t>(path, IO::ASYNC_IN, "ascii", 7).read() == expected) << std::endl;
+    write_bytes(path, zstd_raw_frame("abc\n") + zstd_raw_frame("def\n"));
+    {
+      const auto result = IO::open<char8_t>(path, IO::IN).read();
+      std::cout << std::string(result.begin(), result.end());
+    }
+    write_bytes(path, zstd_raw_frame(content).substr(0, 5000));
+    print_read(path);
+
+    // ZstdWriter のフレーム（チェックサムなし）を小さなバッファで読む（入力を読み終えた後にも出力が残る）
+    for(unsigned number_of_threads: {0u, 2u}){
+      {
+        IO::OutputStream<char8_t> out(IO::BINARY_TOOLS::make_encoder<char8_t>(IO::BINARY_TOOLS::make_zstd_writer(IO::BINARY_TOOLS::make_binary_file_writer(path), {std::nullopt, number_of_threads}), "ascii"));
+        out(std::u8string_view(expected));
+        out.close();
+      }
+      for(std::size_t buffer_size: {1, 2, 3, 7, 100, 0}){
+        IO::InputStream<char8_t> stream(IO::BINARY_TOOLS::make_decoder<char8_t>(IO::BINARY_TOOLS::make_zstd_reader(IO::BINARY_TOOLS::make_binary_file_reader(path)), "ascii"), buffer_size);
+        std::cout << (stream.read() == expected) << " ";
+      }
+      std::cout << std::endl;
+    }
+#else
+    print_read(path);
+#endif
+  }
+
+  std::remove(path.c_str());
+
+}
@@ -0,0 +1,101 @@
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "IO.hpp"
+
+
+template<class InputType>
+void print_lines(InputType&& input)
+{
+  for(auto&& line: ACCBOOST2::IO::lines(std::forward<InputType>(input))){
+    std::cout << line.number << "[";
+    for(auto c: line.value){
+      if(c == '\r') std::cout << "\\r";
+      else std::cout << static_cast<char>(c);
+    }
+    std::cout << "] ";
+  }
+  std::cout << std::endl;
+}
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  const std::string path = "test_LineSplitter.tmp";
+
+  print_lines(std::string_view("a\r\nbb\n\nccc"));
+  print_lines(std::string_view("a\n"));
+  print_lines(std::string_view("\n"));
+  print_lines(std::string_view(""));
+  print_lines(std::string_view("a\r\r\n\r"));
+  print_lines(std::string("x\ny\r\n"));
+  print_lines(std::u8string_view(u8"あ\nい"));
+
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "hello\r\nworld\n\nlast";
+  }
+  for(std::size_t buffer_size: {1, 3, 0}){
+    print_lines(IO::open<char8_t>(path, IO::IN, "ascii", buffer_size));
+  }
+  {
+    // ストリームの先頭と末尾の改行
+    std::ofstream file(path, std::ios::binary);
+    file << "\nabc\n";
+  }
+  print_lines(IO::open<char8_t>(path, IO::IN, "ascii", 1));
+
+  {
+    // 小さなバッファで読んでも（行がバッファの境界をまたいでも）文字列から分けた結果と同じになる
+    std::string data;
+    unsigned x = 1;
+    for(int i = 0; i < 20000; ++i){
+      x = x * 1103515245 + 12345;
+      const int r = (x >> 16) % 10;
+      data.push_back(r < 2 ? '\n' : r < 3 ? '\r' : static_cast<char>('a' + r));
+    }
+    {
+      std::ofstream file(path, std::ios::binary);
+      file << data;
+    }
+    std::vector<std::string> expected;
+    for(auto&& line: IO::lines(std::string_view(data))){
+      expected.emplace_back(line.value);
+    }
+    std::cout << expected.size() << std::endl;
+    for(std::size_t buffer_size: {1, 2, 3, 7, 64, 4096, 0}){
+      std::size_t i = 0;
+      bool ok = true;
+      for(auto&& line: IO::lines(IO::open<char8_t>(path, IO::IN, "ascii", buffer_size))){
+        ok = ok && i < expected.size() && line.number == i + 1 && std::string(line.value.begin(), line.value.end()) == expected[i];
+        ++i;
+      }
+      std::cout << (ok && i == expected.size()) << " ";
+    }
+    {
+      // char32_t のストリームと非同期の読み込み
+      std::size_t i = 0;
+      bool ok = true;
+      for(auto&& line: IO::lines(IO::open<char32_t>(path, IO::IN, "utf-8", 5))){
+        ok = ok && i < expected.size() && line.value.size() == expected[i].size();
+        ++i;
+      }
+      std::cout << (ok && i == expected.size()) << " ";
+      i = 0;
+      for(auto&& line: IO::lines(IO::open<char8_t>(path, IO::ASYNC_IN, "ascii", 3))){
+        ok = ok && i < expected.size() && std::string(line.value.begin(), line.value.end()) == expected[i];
+        ++i;
+      }
+      std::cout << (ok && i == expected.size()) << std::endl;
+    }
+  }
+
+  std::remove(path.c_str());
+
+}
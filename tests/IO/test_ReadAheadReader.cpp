@@ -0,0 +1,106 @@
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "IO.hpp"
+
+
+/// size バイトを返した後で例外を投げる BinaryReader．
+class BrokenReader: public ACCBOOST2::IO::BINARY_TOOLS::BinaryReader
+{
+private:
+
+  std::size_t _size;
+
+public:
+
+  explicit BrokenReader(std::size_t size):
+    _size(size)
+  {}
+
+  std::size_t min_buffer_size() const noexcept override
+  {
+    return 1;
+  }
+
+  std::size_t operator()(char_type* buffer, std::size_t limit) override
+  {
+    if(_size == 0) throw std::runtime_error("broken reader.");
+    const std::size_t n = std::min(limit, _size);
+    std::memset(buffer, 'x', n);
+    _size -= n;
+    return n;
+  }
+
+  void close() noexcept override
+  {}
+
+};
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  const std::string path = "test_ReadAheadReader.tmp";
+
+  std::u8string content;
+  for(int i = 0; i < 2000; ++i){
+    content += IO::convert<char8_t>(std::to_string(i) + ",abc\n");
+  }
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(content.data()), content.size());
+  }
+
+  for(std::size_t number_of_buffers: {1, 2, 4}){
+    for(std::size_t buffer_size: {1, 7, 4096, 1 << 20}){
+      auto reader = IO::BINARY_TOOLS::make_read_ahead_reader(IO::BINARY_TOOLS::make_binary_file_reader(path), number_of_buffers, buffer_size);
+      IO::InputStream<char8_t> stream(IO::BINARY_TOOLS::make_decoder<char8_t>(std::move(reader), "utf-8"), 5);
+      std::cout << (stream.read() == content) << " ";
+    }
+    std::cout << std::endl;
+  }
+
+  {
+    std::size_t count = 0;
+    for(auto&& token: IO::split(IO::open<char8_t>(path, IO::ASYNC_IN), u8'\n')){
+      count += !token.empty();
+    }
+    std::cout << count << std::endl;
+  }
+
+  {
+    // 読み終える前に破棄する
+    auto stream = IO::open<char8_t>(path, IO::ASYNC_IN, "ascii", 16);
+    stream.next();
+    std::cout << static_cast<char>(*stream.begin()) << std::endl;
+  }
+
+  {
+    // 読み込み側のスレッドで投げられた例外は，先読みした分を読み終えてから呼び出し側に投げられる
+    auto reader = IO::BINARY_TOOLS::make_read_ahead_reader(std::make_unique<BrokenReader>(10), 2, 4);
+    std::byte buffer[16];
+    std::size_t total = 0;
+    try{
+      while(1){
+        total += (*reader)(buffer, sizeof(buffer));
+      }
+    }catch(std::runtime_error& e){
+      std::cout << total << " " << e.what() << std::endl;
+    }
+  }
+
+  try{
+    IO::open<char8_t>(path + ".nonexistent", IO::ASYNC_IN).read();
+  }catch(std::runtime_error&){
+    std::cout << "runtime_error" << std::endl;
+  }
+
+  std::remove(path.c_str());
+
+}
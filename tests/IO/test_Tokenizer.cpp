@@ -0,0 +1,94 @@
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "IO.hpp"
+
+
+template<class InputType>
+std::string dump(InputType&& input, const ACCBOOST2::IO::TokenizerFormat& format)
+{
+  std::string result;
+  try{
+    for(auto&& field: ACCBOOST2::IO::tokenize(std::forward<InputType>(input), format)){
+      result += std::to_string(field.line) + ":" + std::to_string(field.index) + "[";
+      for(auto c: field.value){
+        if(c == '\r') result += "\\r";
+        else if(c == '\n') result += "\\n";
+        else if(static_cast<std::uint32_t>(c) < 0x80) result.push_back(static_cast<char>(c));
+        else result += "U+" + std::to_string(static_cast<std::uint32_t>(c));
+      }
+      result += "] ";
+    }
+  }catch(std::runtime_error& e){
+    result += e.what();
+  }
+  return result;
+}
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  // CSV
+  std::cout << dump(std::string_view("a,b,c\nd,e,f\n"), IO::CSV) << std::endl;
+  std::cout << dump(std::string_view("a,,c\n,\n,x,\n"), IO::CSV) << std::endl;       // 空のフィールド
+  std::cout << dump(std::string_view("a,b\r\nc,d\r\n\r\ne"), IO::CSV) << std::endl;  // CRLF と空行，末尾に改行がない
+  std::cout << dump(std::string_view("\"a,b\",\"c\"\"d\"\"\",\"\"\n"), IO::CSV) << std::endl;  // 引用符
+  std::cout << dump(std::string_view("\"x\ny\",z\n2\n"), IO::CSV) << std::endl;      // 引用符の中の改行
+  std::cout << dump(std::string_view("a,\"b\"\r\nc,\"d\r\"\r\n"), IO::CSV) << std::endl;  // 引用符の後の CRLF
+  std::cout << dump(std::string_view("\"\"\"\"\n"), IO::CSV) << std::endl;
+  std::cout << dump(std::string_view("a,\"bc"), IO::CSV) << std::endl;              // 閉じていない引用符
+  std::cout << dump(std::string_view(""), IO::CSV) << std::endl;
+  std::cout << dump(std::string_view("\n\n"), IO::CSV) << std::endl;
+
+  // 空白区切り
+  std::cout << dump(std::string_view("  NAME  TEST\n\n ROWS\n  N  obj \t\r\n"), IO::WHITESPACE) << std::endl;
+  std::cout << dump(std::string_view("a\"b c\n \t \nd"), IO::WHITESPACE) << std::endl;
+
+  // その他の書式と文字の型
+  std::cout << dump(std::u8string_view(u8"a;b|c\nd;;"), IO::TokenizerFormat{IO::DelimiterSet(";|"), false, false}) << std::endl;
+  std::cout << dump(std::u32string_view(U"α β\n\U0001F600,γ"), IO::WHITESPACE) << std::endl;
+  std::cout << dump(std::u32string_view(U"α,\"β,\"\n"), IO::CSV) << std::endl;
+
+  // ストリームから小さなバッファで読んでも（フィールドがバッファの境界をまたいでも）同じ結果になる
+  {
+    const std::string path = "test_Tokenizer.tmp";
+    std::string data;
+    unsigned x = 1;
+    for(int i = 0; i < 3000; ++i){
+      x = x * 1103515245 + 12345;
+      const char* pieces[] = {"a", "bc", ",", "\n", "\r\n", "\"q,\"\"\n\"", " ", "", "defghijkl"};
+      data += pieces[(x >> 16) % 9];
+    }
+    if(data.back() == '"') data.pop_back();
+    {
+      std::ofstream file(path, std::ios::binary);
+      file << data;
+    }
+    for(auto&& format: {IO::CSV, IO::WHITESPACE}){
+      const std::string expected = dump(std::string_view(data), format);
+      std::cout << expected.size() << " ";
+      for(std::size_t buffer_size: {1, 2, 5, 4096}){
+        std::cout << (dump(IO::open<char8_t>(path, IO::IN, "ascii", buffer_size), format) == expected) << " ";
+      }
+      std::cout << (dump(std::string(data), format) == expected) << std::endl;
+    }
+    std::remove(path.c_str());
+  }
+
+  {
+    // string_to と組み合わせる
+    double sum = 0;
+    for(auto&& field: IO::tokenize(std::string_view("1,2.5,x\n3,4.5,\"y,z\"\n"), IO::CSV)){
+      if(field.index < 2) sum += IO::string_to<double>(field.value);
+    }
+    std::cout << sum << std::endl;
+  }
+
+}
@@ -0,0 +1,85 @@
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <unistd.h>
+
+#include "IO.hpp"
+
+
+void write_file(const std::string& path, std::size_t size)
+{
+  std::ofstream file(path, std::ios::binary);
+  for(std::size_t i = 0; i < size; ++i){
+    file.put(static_cast<char>('a' + i % 26));
+  }
+}
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  const std::string path = "test_buffer_size.tmp";
+
+  // 通常のファイルから読み込むときは，ファイルの大きさを min_buffer_size() の倍数に切り上げる（ただし 256 KiB まで）
+  for(std::size_t size: {0, 100, 5000, 300000}){
+    write_file(path, size);
+    auto reader = IO::BINARY_TOOLS::make_binary_file_reader(path);
+    const std::size_t min_size = reader->min_buffer_size();
+    const std::size_t expected = std::clamp((size + min_size - 1) / min_size * min_size, min_size, std::max<std::size_t>(min_size, 1 << 18));
+    std::cout << (reader->preferred_buffer_size() == expected) << " ";
+    IO::InputStream<char8_t> stream(IO::BINARY_TOOLS::make_decoder<char8_t>(std::move(reader), "ascii"));
+    std::cout << (stream.buffer_size() == std::max<std::size_t>(expected, 1024)) << " ";
+    std::size_t count = 0;
+    for(auto&& c: stream){
+      count += (c == static_cast<char8_t>('a' + count % 26));
+    }
+    std::cout << (count == size) << std::endl;
+  }
+
+  {
+    // 指定された大きさが min_buffer_size() 未満ならば切り上げる
+    auto reader = IO::BINARY_TOOLS::make_binary_file_reader(path);
+    const std::size_t min_size = reader->min_buffer_size();
+    IO::InputStream<char8_t> stream(IO::BINARY_TOOLS::make_decoder<char8_t>(std::move(reader), "ascii"), 1);
+    std::cout << (stream.buffer_size() == min_size) << std::endl;
+  }
+
+  {
+    // パイプは 64 KiB
+    int fds[2];
+    if(::pipe(fds) != 0) return 1;
+    auto reader = IO::BINARY_TOOLS::make_binary_fd_reader(fds[0]);
+    std::cout << (reader->preferred_buffer_size() == std::max<std::size_t>(reader->min_buffer_size(), 1 << 16)) << " ";
+    IO::BINARY_TOOLS::BinaryFDWriter writer(fds[1]);
+    std::cout << writer.preferred_buffer_size() << std::endl;
+    ::close(fds[0]);
+    ::close(fds[1]);
+  }
+
+  {
+    // 通常のファイルへ書き込むときは 256 KiB，推奨値がなければ（文字デバイスなど）4096
+    std::cout << IO::open<char8_t>(path, IO::OUT).buffer_size() << " ";
+    std::cout << IO::open<char8_t>("/dev/null", IO::OUT).buffer_size() << " ";
+    std::cout << IO::open<char8_t>(path, IO::OUT, "ascii", 3).buffer_size() << std::endl;
+  }
+
+  for(std::size_t buffer_size: {1, 2, 3, 4096, 0}){
+    {
+      auto out = IO::open<char8_t>(path, IO::OUT, "ascii", buffer_size);
+      for(int i = 0; i < 1000; ++i){
+        out(i, ",", u8"abc", "\n");
+      }
+    }
+    std::ifstream file(path, std::ios::binary);
+    const std::string content(std::istreambuf_iterator<char>(file), {});
+    std::cout << content.size() << " " << content.substr(content.size() - 8);
+  }
+
+  std::remove(path.c_str());
+
+}
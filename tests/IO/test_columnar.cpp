@@ -0,0 +1,257 @@
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include "IO.hpp"
+
+
+enum class Color: std::int16_t {RED = 1, BLUE = -2};
+
+struct Point
+{
+  double x;
+  int y;
+};
+
+
+std::string read_bytes(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+
+void write_bytes(const std::string& path, const std::string& bytes)
+{
+  std::ofstream file(path, std::ios::binary);
+  file.write(bytes.data(), bytes.size());
+}
+
+
+/// Header の一部を書き換えて，Header のチェックサムを計算し直す．
+template<class F>
+std::string modify_header(std::string bytes, F&& f)
+{
+  using namespace ACCBOOST2::IO::_impl_columnar;
+  Header header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+  f(header);
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  header.header_checksum = header_checksum(reinterpret_cast<const std::byte*>(bytes.data()), sizeof(Header) + sizeof(ColumnHeader) * header.number_of_columns);
+  std::memcpy(bytes.data(), &header, sizeof(header));
+  return bytes;
+}
+
+
+template<class F>
+void print_error(F&& f)
+{
+  try{
+    f();
+    std::cout << "not thrown" << std::endl;
+  }catch(std::runtime_error& e){
+    std::cout << e.what() << std::endl;
+  }
+}
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  const std::string path = "test_columnar.tmp";
+
+  {
+    Array<double> a;
+    for(int i = 0; i < 1000; ++i){
+      a.push_back(i * 0.5);
+    }
+    IO::save(path, a, true);
+    Array<double> b;
+    b.push_back(42);
+    IO::load(path, b);
+    std::cout << b.size() << " " << b[0] << " " << b[999] << std::endl;
+
+    IO::ColumnarFile file(path);
+    const auto column = file.column<double>(0);
+    std::cout << file.size() << " " << file.has_checksum() << " " << file.byte_swapped() << " " << column.size() << " " << column[3] << " " << (reinterpret_cast<std::uintptr_t>(column.data()) % 64) << std::endl;
+    file.verify();
+    print_error([&]{file.column<float>(0);});
+    print_error([&]{file.column<double>(1);});
+  }
+
+  {
+    Array<Point> a;
+    a.push_back(Point{1.5, 3});
+    a.push_back(Point{-2.0, 4});
+    IO::save(path, a);
+    Array<Point> b;
+    IO::load(path, b);
+    std::cout << b.size() << " " << b[1].x << " " << b[1].y << " " << IO::ColumnarFile(path).has_checksum() << std::endl;
+
+    Array<int> empty;
+    IO::save(path, empty, true);
+    Array<int> c{1, 2};
+    IO::load(path, c);
+    std::cout << c.size() << std::endl;
+  }
+
+  {
+    ZippedArray<int, double, Color, char> a;
+    for(int i = 0; i < 77; ++i){
+      a.push_back(i, i * 2.0, i % 2 ? Color::RED : Color::BLUE, static_cast<char>('a' + i % 26));
+    }
+    IO::save(path, a, true);
+    ZippedArray<int, double, Color, char> b;
+    IO::load(path, b);
+    bool equal = b.size() == a.size();
+    for(std::size_t i = 0; equal && i < a.size(); ++i){
+      equal = b[i] == a[i];
+    }
+    std::cout << b.size() << " " << equal << std::endl;
+    Array<double> c;
+    print_error([&]{IO::load(path, c);});
+    ZippedArray<int, float, Color, char> d;
+    print_error([&]{IO::load(path, d);});
+  }
+
+  {
+    Sparse2DArray<double, SPARSE_ASSEMBLY::List, std::uint32_t> a(50, 40);
+    for(int k = 0; k < 300; ++k){
+      a.emplace((k * 7) % 50, (k * 13) % 40, k * 1.0);
+    }
+    IO::save(path, a, true);
+    Sparse2DArray<double, SPARSE_ASSEMBLY::List, std::uint32_t> b(3, 3);
+    b.emplace(1, 1, 5.0);
+    IO::load(path, b);
+    bool equal = true;
+    std::size_t nnz_a = 0;
+    std::size_t nnz_b = 0;
+    for(std::size_t i = 0; i < a.row_size(); ++i){
+      for(auto&& [r, c, v]: a.row(i)){
+        equal = equal && b.contain(r, c) && b.get(r, c) == v;
+        ++nnz_a;
+      }
+      nnz_b += b.row(i).size();
+    }
+    std::cout << b.row_size() << " " << b.column_size() << " " << nnz_a << " " << nnz_b << " " << equal << std::endl;
+  }
+
+  {
+    // 壊れたファイル
+    Array<double> a;
+    for(int i = 0; i < 100; ++i){
+      a.push_back(i);
+    }
+    IO::save(path, a, true);
+    const std::string bytes = read_bytes(path);
+
+    // チェックサムが一致しない
+    std::string corrupted = bytes;
+    corrupted[corrupted.size() - 3] ^= 0x55;
+    write_bytes(path, corrupted);
+    print_error([&]{IO::load(path, a);});
+    print_error([&]{IO::ColumnarFile(path).verify();});
+
+    // 途切れたファイル
+    write_bytes(path, bytes.substr(0, bytes.size() - 8));
+    print_error([&]{IO::load(path, a);});
+    write_bytes(path, bytes.substr(0, 60));
+    print_error([&]{IO::load(path, a);});
+    write_bytes(path, bytes.substr(0, 7));
+    print_error([&]{IO::load(path, a);});
+    write_bytes(path, "");
+    print_error([&]{IO::load(path, a);});
+
+    // マジックナンバーと版
+    std::string other = bytes;
+    other[0] = 'X';
+    write_bytes(path, other);
+    print_error([&]{IO::load(path, a);});
+    other = bytes;
+    other[12] = 99;
+    write_bytes(path, other);
+    print_error([&]{IO::load(path, a);});
+
+    print_error([&]{IO::load(path + ".nonexistent", a);});
+
+    // Header の要素数が列と一致しない
+    write_bytes(path, modify_header(bytes, [](auto& header){header.size = 101;}));
+    print_error([&]{IO::load(path, a);});
+    other = bytes;
+    other[24] ^= 1;
+    write_bytes(path, other);
+    print_error([&]{IO::load(path, a);});
+  }
+
+  {
+    // Sparse2DArray の Header の大きさ（メモリを確保する前に検査する）
+    Sparse2DArray<double, SPARSE_ASSEMBLY::List, std::uint32_t> a(5, 4);
+    a.emplace(1, 2, 3.0);
+    a.emplace(4, 3, 5.0);
+    IO::save(path, a, true);
+    const std::string bytes = read_bytes(path);
+    Sparse2DArray<double, SPARSE_ASSEMBLY::List, std::uint32_t> b(1, 1);
+
+    std::string other = bytes;
+    other[40 + 4] = 2;
+    write_bytes(path, other);
+    print_error([&]{IO::load(path, b);});
+    write_bytes(path, modify_header(bytes, [](auto& header){header.column_size = std::uint64_t{1} << 33;}));
+    print_error([&]{IO::load(path, b);});
+    print_error([&]{IO::ColumnarFile(path).verify();});
+    write_bytes(path, modify_header(bytes, [](auto& header){header.row_size = 4;}));
+    print_error([&]{IO::load(path, b);});
+    write_bytes(path, modify_header(bytes, [](auto& header){header.row_size = ~std::uint64_t{0};}));
+    print_error([&]{IO::load(path, b);});
+    write_bytes(path, modify_header(bytes, [](auto& header){header.column_size = 3;}));
+    print_error([&]{IO::load(path, b);});
+
+    write_bytes(path, bytes);
+    IO::load(path, b);
+    std::cout << b.row_size() << " " << b.column_size() << " " << b.get(1, 2) << " " << b.get(4, 3) << std::endl;
+  }
+
+  {
+    // バイト順が異なるファイル（チェックサムなし）は load で読めるが column では読めない
+    Array<double> a;
+    for(int i = 0; i < 100; ++i){
+      a.push_back(i * 0.25);
+    }
+    IO::save(path, a);
+    std::string bytes = read_bytes(path);
+    IO::_impl_columnar::Header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    IO::_impl_columnar::ColumnHeader column_header;
+    std::memcpy(&column_header, bytes.data() + sizeof(header), sizeof(column_header));
+    for(std::size_t i = 0; i < column_header.size; ++i){
+      char* p = bytes.data() + column_header.offset + i * sizeof(double);
+      std::reverse(p, p + sizeof(double));
+    }
+    IO::_impl_columnar::byteswap_header(header);
+    IO::_impl_columnar::byteswap_column_header(column_header);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + sizeof(header), &column_header, sizeof(column_header));
+    // Header のチェックサムはファイルのバイト列から計算し，書いた計算機のバイト順で置く
+    header.header_checksum = IO::_impl_columnar::header_checksum(reinterpret_cast<const std::byte*>(bytes.data()), sizeof(header) + sizeof(column_header));
+    IO::_impl_columnar::byteswap(&header.header_checksum, 1);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    write_bytes(path, bytes);
+
+    IO::ColumnarFile file(path);
+    std::cout << file.byte_swapped() << std::endl;
+    print_error([&]{file.column<double>(0);});
+    Array<double> b;
+    IO::load(path, b);
+    std::cout << b.size() << " " << b[1] << " " << b[99] << std::endl;
+  }
+
+  std::remove(path.c_str());
+
+}
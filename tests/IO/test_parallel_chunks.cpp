@@ -0,0 +1,134 @@
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include "IO.hpp"
+
+
+void print_chunks(std::string_view data, std::size_t chunk_size)
+{
+  for(auto&& chunk: ACCBOOST2::IO::split_into_chunks(data, '\n', chunk_size)){
+    std::cout << "[";
+    for(char c: chunk){
+      if(c == '\n') std::cout << "\\n";
+      else std::cout << c;
+    }
+    std::cout << "]";
+  }
+  std::cout << std::endl;
+}
+
+
+/// 既定構築も代入もできない結果の型．
+struct Sum
+{
+  std::size_t first_line;
+  std::size_t value;
+
+  Sum(std::size_t first_line, std::size_t value):
+    first_line(first_line), value(value)
+  {}
+
+  Sum(Sum&&) = default;
+  Sum& operator=(Sum&&) = delete;
+};
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  // チャンクの境界
+  print_chunks("", 3);
+  print_chunks("abc", 1);
+  print_chunks("abc", 0);
+  print_chunks("a\nb\nc\n", 1);
+  print_chunks("aaaa\nb", 2);
+  print_chunks("ab\ncd\n", 2);
+  print_chunks("ab\ncd\n", 3);
+  print_chunks("ab\ncd\n", 4);
+  print_chunks("ab\ncd\n", 6);
+  print_chunks("\n\n\n\n", 2);
+  print_chunks("abcdef\n", 3);
+
+  {
+    // チャンクをつなげると元の文字列になり，最後以外のチャンクは chunk_size 以上で区切り文字で終わる
+    std::string data;
+    unsigned x = 1;
+    for(int i = 0; i < 5000; ++i){
+      x = x * 1103515245 + 12345;
+      data.push_back((x >> 16) % 8 == 0 ? '\n' : 'a');
+    }
+    bool ok = true;
+    for(std::size_t chunk_size: {1, 2, 3, 10, 100, 4999, 5000, 5001}){
+      const auto chunks = IO::split_into_chunks(std::string_view(data), '\n', chunk_size);
+      std::string joined;
+      for(std::size_t k = 0; k < chunks.size(); ++k){
+        joined += chunks[k];
+        if(k + 1 != chunks.size()){
+          ok = ok && chunks[k].size() >= chunk_size && chunks[k].back() == '\n';
+        }
+      }
+      ok = ok && joined == data;
+    }
+    std::cout << ok << std::endl;
+  }
+
+  const std::string path = "test_parallel_chunks.tmp";
+  {
+    std::ofstream file(path);
+    for(int i = 0; i < 10000; ++i){
+      file << i << "\n";
+    }
+  }
+
+  ThreadPool thread_pool(4);
+
+  for(std::size_t chunk_size: {1, 100, 1000, 1 << 20}){
+    std::atomic<std::size_t> sum = 0;
+    std::atomic<std::size_t> number_of_chunks = 0;
+    IO::parallel_for_each_chunk(path, [&](std::u8string_view chunk)
+    {
+      for(auto&& line: IO::lines(chunk)){
+        sum += IO::string_to<std::size_t>(line.value);
+      }
+      ++number_of_chunks;
+    }, u8'\n', chunk_size, thread_pool);
+    std::cout << sum << " " << number_of_chunks << " ";
+
+    // 結果は元の順序で渡される
+    std::size_t total = 0;
+    std::size_t next_line = 0;
+    bool ordered = true;
+    IO::parallel_transform_chunks(path, [](std::u8string_view chunk)
+    {
+      std::size_t value = 0;
+      for(auto&& line: IO::lines(chunk)){
+        value += IO::string_to<std::size_t>(line.value);
+      }
+      const auto first_line = IO::string_to<std::size_t>(chunk.substr(0, chunk.find(u8'\n')));
+      return Sum(first_line, value);
+    }, [&](Sum&& result)
+    {
+      ordered = ordered && result.first_line >= next_line;
+      next_line = result.first_line + 1;
+      total += result.value;
+    }, u8'\n', chunk_size, thread_pool, 1);
+    std::cout << total << " " << ordered << std::endl;
+  }
+
+  {
+    // 空のファイルにはチャンクがない
+    { std::ofstream file(path); }
+    std::size_t number_of_chunks = 0;
+    IO::parallel_for_each_chunk(path, [&](std::u8string_view){++number_of_chunks;}, u8'\n', 1, thread_pool);
+    IO::parallel_transform_chunks(path, [](std::u8string_view chunk){return chunk.size();}, [&](std::size_t){++number_of_chunks;}, u8'\n', 1, thread_pool);
+    std::cout << number_of_chunks << std::endl;
+  }
+
+  std::remove(path.c_str());
+
+}
@@ -0,0 +1,94 @@
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "IO.hpp"
+
+
+template<class InputStreamType>
+auto read_all(InputStreamType&& stream)
+{
+  std::basic_string<typename std::remove_reference_t<InputStreamType>::char_type> result;
+  for(auto&& c: stream){
+    result.push_back(c);
+  }
+  return result;
+}
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+  using namespace ACCBOOST2::IO::BINARY_TOOLS;
+
+  const std::string path = "test_static_reader.tmp";
+
+  std::u8string content;
+  for(int i = 0; i < 3000; ++i){
+    content += IO::convert<char8_t>(std::to_string(i)) + u8",あx\U0001F600\n";
+  }
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(content.data()), content.size());
+  }
+
+  // 文字コードをコンパイル時に指定すると，Reader を値で持つ InputStream になる
+  static_assert(std::is_same_v<decltype(IO::open<char8_t>(path, IO::IN, IO::UTF8)), IO::InputStream<char8_t, UTF8Decoder<FileReader>>>);
+  static_assert(std::is_same_v<decltype(IO::open<char8_t>(path, IO::IN, IO::ASCII)), IO::InputStream<char8_t, AsciiDecoder<FileReader>>>);
+
+  for(std::size_t buffer_size: {0, 1, 1027, 4099, 65536}){
+    std::cout << (read_all(IO::open<char8_t>(path, IO::IN, IO::UTF8, buffer_size)) == content) << " ";
+    std::cout << (read_all(IO::open<char8_t>(path, IO::IN, "utf-8", buffer_size)) == content) << " ";
+    std::cout << (read_all(IO::InputStream<char32_t, UTF8ToUTF32Decoder<FileReader>>(UTF8ToUTF32Decoder<FileReader>(FileReader(path)), buffer_size)) == IO::convert<char32_t>(content)) << std::endl;
+  }
+
+  {
+    // 静的な Reader を仮想関数を介して呼び出す
+    using ReaderType = UTF8Decoder<FileReader>;
+    std::unique_ptr<U8Reader> reader = std::make_unique<DynamicReader<ReaderType>>(ReaderType(FileReader(path)));
+    std::cout << (read_all(IO::InputStream<char8_t>(std::move(reader), 100)) == content) << std::endl;
+  }
+
+  {
+    // std::shared_ptr で共有している BinaryReader を IndirectReader を介して読む（Decoder を閉じても BinaryReader は閉じない）
+    std::shared_ptr<BinaryReader> binary_reader = make_binary_file_reader(path);
+    std::u8string result;
+    {
+      IO::InputStream<char8_t> stream(make_decoder<char8_t>(binary_reader, "utf-8"));
+      for(auto&& c: stream){
+        result.push_back(c);
+      }
+    }
+    std::cout << (result == content) << " " << binary_reader.use_count() << std::endl;
+  }
+
+  {
+    // ascii で読めない文字があれば例外を投げる
+    try{
+      read_all(IO::open<char8_t>(path, IO::IN, IO::ASCII));
+      std::cout << "not thrown" << std::endl;
+    }catch(std::runtime_error& e){
+      std::cout << e.what() << std::endl;
+    }
+    try{
+      read_all(IO::open<char8_t>(path, IO::IN, "ascii"));
+      std::cout << "not thrown" << std::endl;
+    }catch(std::runtime_error& e){
+      std::cout << e.what() << std::endl;
+    }
+  }
+
+  {
+    std::size_t count = 0;
+    for(auto&& token: IO::split(IO::open<char8_t>(path, IO::IN, IO::UTF8), u8'\n')){
+      count += !token.empty();
+    }
+    std::cout << count << std::endl;
+  }
+
+  std::remove(path.c_str());
+
+}
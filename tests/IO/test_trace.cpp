@@ -0,0 +1,63 @@
+
+#define ACCBOOST2_IO_TRACE
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include "IO.hpp"
+
+
+void print_trace(ACCBOOST2::IO::TraceStage stage)
+{
+  const auto record = ACCBOOST2::IO::trace_summary(stage);
+  std::cout << ACCBOOST2::IO::trace_stage_name(stage) << " " << record.calls << " " << record.bytes << std::endl;
+}
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  const std::string path = "test_trace.tmp";
+
+  IO::reset_trace();
+  {
+    auto out = IO::open<char8_t>(path, IO::OUT, "ascii", 4);
+    for(int i = 0; i < 5; ++i){
+      out(i, " ", i * 10, "\n");
+    }
+  }
+  print_trace(IO::TraceStage::flush);
+  print_trace(IO::TraceStage::encode);
+  print_trace(IO::TraceStage::write);
+
+  IO::reset_trace();
+  {
+    int sum = 0;
+    for(auto&& token: IO::split(IO::open<char8_t>(path, IO::IN, "ascii", 4), u8'\n')){
+      if(!token.empty()) sum += IO::string_to<int>(token.substr(0, token.find(u8' ')));
+    }
+    std::cout << sum << std::endl;
+  }
+  print_trace(IO::TraceStage::read);
+  print_trace(IO::TraceStage::decode);
+  print_trace(IO::TraceStage::split);
+  print_trace(IO::TraceStage::string_to);
+  print_trace(IO::TraceStage::compress);
+
+  {
+    // 呼び出されていない段階は出力しない
+    IO::reset_trace();
+    IO::TraceScope(IO::TraceStage::string_to).add_bytes(3);
+    std::ostringstream stream;
+    IO::report_trace(stream);
+    std::cout << stream.str().substr(0, stream.str().find('\t', stream.str().find('\n'))) << std::endl;
+    IO::reset_trace();
+    print_trace(IO::TraceStage::string_to);
+  }
+
+  std::remove(path.c_str());
+
+}
@@ -0,0 +1,166 @@
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include "IO.hpp"
+
+
+void write_bytes(const std::string& path, const std::string& bytes)
+{
+  std::ofstream file(path, std::ios::binary);
+  file.write(bytes.data(), bytes.size());
+}
+
+
+std::string read_bytes(const std::string& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+
+template<class CharT>
+void print_code_points(const std::string& path, const std::string& encoding, std::size_t buffer_size = 0)
+{
+  try{
+    for(auto&& c: ACCBOOST2::IO::open<CharT>(path, ACCBOOST2::IO::IN, encoding, buffer_size)){
+      std::cout << std::hex << static_cast<std::uint32_t>(c) << std::dec << " ";
+    }
+    std::cout << std::endl;
+  }catch(std::runtime_error& e){
+    std::cout << e.what() << std::endl;
+  }
+}
+
+
+template<class CharT, class StringType>
+void print_convert(const StringType& s)
+{
+  try{
+    for(auto&& c: ACCBOOST2::IO::convert<CharT>(s)){
+      std::cout << std::hex << static_cast<std::uint32_t>(c) << std::dec << " ";
+    }
+    std::cout << std::endl;
+  }catch(std::runtime_error& e){
+    std::cout << e.what() << std::endl;
+  }
+}
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  const std::string path = "test_transcode.tmp";
+
+  // 各長さの UTF-8 と，サロゲートペアになる文字を含む文字列
+  std::u32string text;
+  for(char32_t c: {U'a', U'é', U'あ', U'퟿', U'', U'￿', U'\U00010000', U'\U0001F600', U'\U0010FFFF', U'\n'}){
+    text.push_back(c);
+  }
+  for(char32_t c = 0; c < 3000; ++c){
+    text.push_back(U'0' + c % 10);
+    text.push_back(0x10000 + c * 300);
+    text.push_back(0x80 + c * 18);
+  }
+
+  // IO::convert
+  const auto utf8 = IO::convert<char8_t>(text);
+  const auto utf16 = IO::convert<char16_t>(text);
+  std::cout << utf8.size() << " " << utf16.size() << std::endl;
+  std::cout << (IO::convert<char32_t>(utf8) == text) << " " << (IO::convert<char32_t>(utf16) == text) << " ";
+  std::cout << (IO::convert<char16_t>(utf8) == utf16) << " " << (IO::convert<char8_t>(utf16) == utf8) << std::endl;
+  print_convert<char16_t>(std::u32string(U"a\U0001F600"));
+  print_convert<char8_t>(std::u32string(U"\U0010FFFF"));
+  print_convert<char32_t>(std::string("abc"));
+
+  // 不正な入力
+  print_convert<char32_t>(std::u8string(u8"\xC0\x80"));          // 冗長な表現
+  print_convert<char32_t>(std::u8string(u8"\xED\xA0\x80"));      // サロゲート
+  print_convert<char32_t>(std::u8string(u8"\xF4\x90\x80\x80"));  // U+10FFFF より大きい
+  print_convert<char32_t>(std::u8string(u8"a\xE3\x81"));         // 途切れた文字
+  print_convert<char32_t>(std::u8string(u8"\x80"));
+  print_convert<char8_t>(std::u16string({u'a', char16_t(0xD800), u'b'}));  // 対になっていない上位サロゲート
+  print_convert<char8_t>(std::u16string({char16_t(0xDC00)}));              // 対になっていない下位サロゲート
+  print_convert<char8_t>(std::u16string({u'a', char16_t(0xD83D)}));        // 途切れたサロゲートペア
+  print_convert<char8_t>(std::u32string({char32_t(0xD800)}));
+  print_convert<char8_t>(std::u32string({char32_t(0x110000)}));
+
+  // ファイルへの書き込みと読み込み（バッファの境界で文字が途切れる大きさも試す）
+  for(std::string encoding: {"utf-8", "utf-16le", "utf-16be"}){
+    for(std::size_t buffer_size: {1, 7, 4096, 0}){
+      {
+        auto out = IO::open<char32_t>(path, IO::OUT, encoding, buffer_size);
+        out(std::u32string_view(text));
+      }
+      std::cout << (IO::open<char32_t>(path, IO::IN, encoding, buffer_size).read() == text) << " ";
+      if(encoding != "utf-8"){
+        {
+          auto out = IO::open<char8_t>(path, IO::OUT, encoding, buffer_size);
+          out(std::u8string_view(utf8));
+        }
+        std::cout << (IO::open<char8_t>(path, IO::IN, encoding, buffer_size).read() == utf8) << " ";
+      }
+    }
+    std::cout << std::endl;
+  }
+
+  // UTF-16 のバイト列
+  {
+    auto out = IO::open<char32_t>(path, IO::OUT, "utf-16le");
+    out(U"a\U0001F600");
+  }
+  for(auto&& c: read_bytes(path)){
+    std::cout << std::hex << (static_cast<unsigned>(c) & 0xFF) << std::dec << " ";
+  }
+  std::cout << std::endl;
+  {
+    auto out = IO::open<char32_t>(path, IO::OUT, "utf-16be");
+    out(U"a\U0001F600");
+  }
+  for(auto&& c: read_bytes(path)){
+    std::cout << std::hex << (static_cast<unsigned>(c) & 0xFF) << std::dec << " ";
+  }
+  std::cout << std::endl;
+
+  // 先頭のバイト順マークは取り除く
+  write_bytes(path, std::string("\xFF\xFE" "a\0\x42\x30\x3D\xD8\x00\xDE", 10));
+  print_code_points<char32_t>(path, "utf-16le");
+  print_code_points<char8_t>(path, "utf-16le", 1);
+  write_bytes(path, std::string("\xFE\xFF" "\0a\x30\x42\xD8\x3D\xDE\x00", 10));
+  print_code_points<char32_t>(path, "utf-16be");
+  print_code_points<char8_t>(path, "utf-16be", 1);
+  write_bytes(path, std::string("a\0\xFF\xFE", 4));
+  print_code_points<char32_t>(path, "utf-16le");
+
+  // 不正なファイル
+  write_bytes(path, "ab\xE3\x81");
+  print_code_points<char32_t>(path, "utf-8");
+  write_bytes(path, "ab\xC0\x80");
+  print_code_points<char32_t>(path, "utf-8");
+  write_bytes(path, std::string("a\0b", 3));
+  print_code_points<char32_t>(path, "utf-16le");
+  write_bytes(path, std::string("a\0\x3D\xD8", 4));
+  print_code_points<char32_t>(path, "utf-16le");
+  write_bytes(path, std::string("a\0\x00\xDE" "b\0", 6));
+  print_code_points<char8_t>(path, "utf-16le");
+
+  {
+    // 途切れた文字を書き込んで閉じると例外を投げる
+    auto out = IO::open<char8_t>(path, IO::OUT, "utf-16le");
+    out(u8"a\xE3\x81");
+    try{
+      out.close();
+      std::cout << "not thrown" << std::endl;
+    }catch(std::runtime_error& e){
+      std::cout << e.what() << std::endl;
+    }
+  }
+
+  std::remove(path.c_str());
+
+}
@@ -0,0 +1,47 @@
+
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+
+#include "ThreadPool.hpp"
+
+
+int main()
+{
+
+  using namespace ACCBOOST2;
+
+  ThreadPool thread_pool(4);
+
+  std::cout << thread_pool.concurrency() << std::endl;
+
+  {
+    std::atomic<std::size_t> sum = 0;
+    thread_pool.run(1000, [&](std::size_t k){sum += k;});
+    std::cout << sum << std::endl;
+  }
+
+  {
+    // タスクの中から run を呼ぶ
+    std::atomic<std::size_t> sum = 0;
+    thread_pool.run(10, [&](std::size_t i)
+    {
+      thread_pool.run(10, [&](std::size_t j){sum += i * 10 + j;});
+    });
+    std::cout << sum << std::endl;
+  }
+
+  {
+    std::atomic<std::size_t> count = 0;
+    thread_pool.run_blocks(12345, [&](std::size_t first, std::size_t last){count += last - first;});
+    std::cout << count << std::endl;
+  }
+
+  try{
+    thread_pool.run(100, [&](std::size_t k){if(k == 42) throw std::runtime_error("42");});
+  }catch(const std::runtime_error& e){
+    std::cout << e.what() << std::endl;
+  }
+
+}
@@ -0,0 +1,34 @@
+#include "parallel_for_each.hpp"
+#include "../container/Array.hpp"
+#include "TEST_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  ThreadPool thread_pool(4);
+  {
+    Array<double> x(1000, 1.0);
+    Array<double> y(1000, 2.0);
+    Array<double> z(1000);
+    parallel_for_each([](auto&& t){
+      auto&& [a, b, c] = t;
+      c = a + b;
+    }, zip(x, y, z), thread_pool);
+    parallel_for_each([](auto&& a, auto&& c){c += a;}, x, z);
+    TEST_UTILS::dump(slice(0, 10, z));
+    parallel_for_each([](auto&& a, auto&& b, auto&& c){c += a * b;}, x, y, z, thread_pool);
+    TEST_UTILS::dump(slice(0, 10, z));
+  }
+  {
+    Array<std::size_t> x(100);
+    parallel_for_each([](auto&& t){
+      auto&& [i, a] = t;
+      a = i * i;
+    }, enumerate(x), thread_pool);
+    TEST_UTILS::dump(slice(0, 10, x));
+  }
+  return 0;
+}
@@ -0,0 +1,52 @@
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+
+#include "parallel_for_rows.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  {
+    // 行の長さが偏った行列を並列に走査する
+    Sparse2DArray<double> b(1000, 1000);
+    for(std::size_t j = 0; j < 1000; ++j){
+      b.emplace(0, j, 1.0);
+    }
+    for(std::size_t i = 1; i < 1000; ++i){
+      b.emplace(i, i, static_cast<double>(i));
+    }
+    ThreadPool thread_pool(4);
+    parallel_for_rows(b, [](std::size_t, auto&& row)
+    {
+      for(auto&& [i, j, v]: row){
+        v *= 2;
+      }
+    }, thread_pool);
+    std::atomic<std::size_t> count = 0;
+    std::atomic<std::size_t> sum = 0;
+    const auto& c = b;
+    parallel_for_columns(c, [&](std::size_t column_index, auto&& column)
+    {
+      count += column.size();
+      for(auto&& [i, j, v]: column){
+        if(j != column_index) throw std::logic_error("");
+        sum += static_cast<std::size_t>(v);
+      }
+    }, thread_pool);
+    std::cout << count << " " << sum << std::endl;
+  }
+
+  {
+    // 空の行列
+    Sparse2DArray<double> b;
+    ThreadPool thread_pool(2);
+    std::size_t count = 0;
+    parallel_for_rows(b, [&](std::size_t, auto&&){++count;}, thread_pool);
+    std::cout << count << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,39 @@
+#include <string>
+#include <vector>
+#include "parallel_reduce.hpp"
+#include "TEST_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  ThreadPool thread_pool(4);
+  {
+    auto x = parallel_reduce([](auto&& a, auto&& b){return a + b;}, std::size_t(0), range(std::size_t(100000)), thread_pool);
+    std::cout << x << std::endl;
+  }
+  {
+    // 結合的だが可換ではない演算
+    auto x = parallel_reduce([](const std::string& a, const std::string& b){return a + b;}, std::string(">"),
+      map([](auto&& i){return std::to_string(i % 10);}, range(30)), thread_pool);
+    std::cout << x << std::endl;
+  }
+  {
+    auto x = parallel_reduce([](auto&& a, auto&& b){return a + b;}, 7, range(0), thread_pool);
+    std::cout << x << std::endl;
+  }
+  {
+    // 畳み込みの型（std::size_t）と要素の型（int）が異なる演算
+    auto x = parallel_reduce([](std::size_t a, int b){return a + (b > 5);}, [](std::size_t a, std::size_t b){return a + b;},
+      std::size_t(0), std::vector<int>(1000, 7), thread_pool);
+    std::cout << x << std::endl;
+  }
+  {
+    auto x = parallel_reduce([](std::string a, int b){return a + std::to_string(b);}, [](const std::string& a, const std::string& b){return a + b;},
+      std::string(">"), std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9}, thread_pool);
+    std::cout << x << std::endl;
+  }
+  return 0;
+}
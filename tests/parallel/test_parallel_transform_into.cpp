@@ -0,0 +1,25 @@
+#include "parallel_transform_into.hpp"
+#include "../container/Array.hpp"
+#include "TEST_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  ThreadPool thread_pool(4);
+  {
+    Array<std::size_t> x(1000);
+    parallel_transform_into(x, map([](auto&& i){return i * 2;}, range(std::size_t(1000))), thread_pool);
+    TEST_UTILS::dump(slice(995, 1000, x));
+  }
+  {
+    Array<double> x(5, 1.5);
+    Array<double> y(5, 2.0);
+    Array<double> z(5);
+    parallel_transform_into(z, map([](auto&& a, auto&& b){return a * b;}, x, y));
+    TEST_UTILS::dump(z);
+  }
+  return 0;
+}
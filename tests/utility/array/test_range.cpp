@@ -5,5 +5,26 @@ int main()
 {
   TEST_UTILS::dump(ACCBOOST2::range<3>());
 
+  static_assert(ACCBOOST2::range<4>()[3] == 3);
+
+  {
+    static_assert(std::ranges::random_access_range<decltype(ACCBOOST2::static_range<4>())>);
+    static_assert(ACCBOOST2::static_range<4>().size() == 4);
+    TEST_UTILS::dump(ACCBOOST2::static_range<4>());
+    constexpr std::size_t sum = []()
+    {
+      std::size_t s = 0;
+      for(auto i: ACCBOOST2::static_range<4>()) s += i;
+      return s;
+    }();
+    static_assert(sum == 6);
+  }
+
+  {
+    std::tuple<int, double, char> x(1, 2.5, 'c');
+    ACCBOOST2::static_for<3>([&](auto i){std::cout << i << ":" << std::get<i>(x) << " ";});
+    std::cout << std::endl;
+  }
+
   return 0;
 }
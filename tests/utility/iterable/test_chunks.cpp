@@ -0,0 +1,50 @@
+#include "chunks.hpp"
+#include <vector>
+#include <iostream>
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  {
+    std::vector<int> x = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto c = chunks<4>(x);
+    static_assert(std::ranges::random_access_range<decltype(c)>);
+    static_assert(std::is_same_v<std::ranges::range_value_t<decltype(c)>, std::span<int, 4>>);
+    std::cout << c.size() << std::endl; // 2
+    for(auto&& block: c){
+      for(auto&& a: block) std::cout << a << " ";
+      std::cout << "| ";
+    }
+    for(auto&& a: c.remainder()) std::cout << a << " ";
+    std::cout << std::endl; // 0 1 2 3 | 4 5 6 7 | 8 9
+  }
+  {
+    std::vector<double> x = {1, 2, 3, 4, 5, 6, 7};
+    const std::vector<double> y = {1, 1, 1, 1, 1, 1, 1, 1};
+    for(auto&& [a, b]: chunks<2>(x, y)){
+      for(std::size_t i = 0; i < 2; ++i) a[i] += b[i];
+    }
+    auto&& [a, b] = chunks<2>(x, y).remainder();
+    static_assert(std::is_same_v<std::remove_cvref_t<decltype(b)>, std::span<const double>>);
+    a[0] += b[0];
+    for(auto&& v: x) std::cout << v << " ";
+    std::cout << std::endl; // 2 3 4 5 6 7 8
+  }
+  {
+    std::vector<int> x = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto c = blocked(3, x);
+    std::cout << c.size() << " " << c.remainder().size() << std::endl; // 4 0
+    for(auto&& block: c){
+      std::cout << block.size() << " ";
+    }
+    std::cout << std::endl; // 3 3 3 1
+  }
+  {
+    std::vector<int> x;
+    std::cout << chunks<4>(x).size() << " " << blocked(4, x).size() << std::endl; // 0 0
+  }
+  return 0;
+}
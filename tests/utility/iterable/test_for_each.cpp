@@ -0,0 +1,34 @@
+#include "for_each.hpp"
+#include "range.hpp"
+#include <vector>
+#include <string>
+#include "TEST_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  {
+    auto x = map([](auto i){return i * i;}, filter([](auto i){return i % 3 == 0;}, range(10)));
+    for_each([](auto y){std::cout << y << " ";}, x);
+    std::cout << std::endl; // 0 9 36 81
+    std::cout << count(x) << " " << reduce([](auto a, auto b){return a + b;}, 0, x) << std::endl; // 4 126
+  }
+  {
+    std::vector<int> x = {3, 1, 4, 1, 5, 9, 2, 6};
+    for_each([](auto&& y){y *= 2;}, filter([](auto y){return y > 3;}, x));
+    TEST_UTILS::dump(x); // 3 1 8 1 10 18 2 12
+  }
+  {
+    std::vector<int> x = {1, 2, 3};
+    std::vector<int> y = {4, 5, 6};
+    std::cout << reduce([](auto a, auto b){return a + b;}, 0, map([](auto a, auto b){return a * b;}, x, y)) << std::endl; // 32
+  }
+  {
+    // 畳み込みの順序
+    std::cout << reduce([](std::string a, auto i){return a + std::to_string(i);}, std::string(">"), filter([](auto i){return i % 2 == 1;}, range(10))) << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,35 @@
+#include "slice.hpp"
+#include "map.hpp"
+#include "range.hpp"
+#include <vector>
+#include "TEST_UTILS.hpp"
+
+
+using namespace ACCBOOST2;
+
+
+int main()
+{
+  std::vector<int> x = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<double> y = {0, 1, 2, 3, 4};
+  {
+    auto s = slice(2, 5, x);
+    static_assert(std::ranges::contiguous_range<decltype(s)>);
+    static_assert(std::ranges::sized_range<decltype(s)>);
+    std::cout << s.size() << " " << (s.data() == x.data() + 2) << " " << s[1] << std::endl;
+    TEST_UTILS::dump(s);
+  }
+  {
+    auto z = zip(x, y);
+    static_assert(std::ranges::sized_range<decltype(z)>);
+    auto [p, q] = z.data();
+    std::cout << z.size() << " " << (p == x.data()) << " " << (q == y.data()) << std::endl;
+  }
+  {
+    auto m = map([](auto&& i){return i * i;}, slice(1, 4, x));
+    static_assert(std::ranges::sized_range<decltype(m)>);
+    std::cout << m.size() << std::endl;
+    TEST_UTILS::dump(m);
+  }
+  return 0;
+}